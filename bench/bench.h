@@ -0,0 +1,96 @@
+/* libScricon: The Simple Graphical Console Library
+ * Copyright (C) 2021-2022 Jyothiraditya Nellakra
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <LSC_buffer.h>
+#include <LSC_error.h>
+
+#ifndef BENCH_H
+#define BENCH_H 1
+
+#define BENCH_SEED 20211221
+#define BENCH_REPS 5
+#define BENCH_SIZES 3
+
+static const size_t bench_sizes[BENCH_SIZES][2] = {
+	{80, 24}, {200, 60}, {400, 120}
+};
+
+static const char *bench_group;
+static FILE *bench_out;
+
+static uint64_t bench_now() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static void bench_setup(LSCb_t *buf, size_t width, size_t height,
+	bool colour)
+{
+	LSCb_init(buf);
+
+	buf -> colour = colour;
+	buf -> width = width;
+	buf -> height = height;
+
+	if(LSCb_alloc(buf) != LSCE_OK) {
+		fputs("Error initialising libScricon.\n", stderr);
+		exit(1);
+	}
+}
+
+static void bench_report(const char *name, LSCb_t *buf, size_t ops,
+	uint64_t ns, double cells, double bytes)
+{
+	fprintf(bench_out? bench_out: stdout,
+		"{\"group\": \"%s\", \"bench\": \"%s\", \"width\": %zu, "
+		"\"height\": %zu, \"colour\": %s, \"ops\": %zu, "
+		"\"ns_per_op\": %.2f, \"cells_per_s\": %.0f, "
+		"\"bytes_per_frame\": %.0f}\n",
+		bench_group, name, buf -> width, buf -> height,
+		buf -> colour? "true": "false", ops, (double) ns / ops,
+		ns? cells * 1e9 / ns: 0.0, bytes);
+
+	fflush(bench_out? bench_out: stdout);
+}
+
+static void bench_run(const char *name, LSCb_t *buf,
+	void (*function)(LSCb_t *buf, size_t ops), size_t ops,
+	double cells, double bytes)
+{
+	uint64_t best = UINT64_MAX;
+
+	for(size_t i = 0; i < BENCH_REPS; i++) {
+		LSCb_clear(buf);
+
+		uint64_t start = bench_now();
+		function(buf, ops);
+		uint64_t ns = bench_now() - start;
+
+		if(ns < best) best = ns;
+	}
+
+	bench_report(name, buf, ops, best, cells, bytes);
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,186 @@
+/* libScricon: The Simple Graphical Console Library
+ * Copyright (C) 2021-2022 Jyothiraditya Nellakra
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#define _GNU_SOURCE
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <threads.h>
+
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <LSC_buffer.h>
+#include <LSC_output.h>
+
+#include "bench.h"
+
+#define OPS 256
+
+static int master = -1;
+
+static LSCo_t out;
+static double encoded;
+
+static void print(LSCb_t *buf, size_t ops) {
+	for(size_t i = 0; i < ops; i++) {
+		LSCb_print(buf, 1);
+		fflush(stdout);
+	}
+}
+
+static void scene(LSCb_t *buf, size_t frame) {
+	for(size_t i = 0; i < 64; i++) {
+		size_t x = (i * 37 + frame) % buf -> width;
+		size_t y = (i * 11) % buf -> height;
+
+		if(buf -> colour) LSCb_setall(buf, x, y, '*', i % 256, 0);
+		else LSCb_set(buf, x, y, '*');
+	}
+}
+
+static void present(LSCb_t *buf) {
+	LSCo_encode(&out, buf);
+	encoded += out.used;
+	LSCo_flush(&out);
+}
+
+static void present_sparse(LSCb_t *buf, size_t ops) {
+	srand(BENCH_SEED);
+
+	for(size_t i = 0; i < ops; i++) {
+		for(size_t j = 0; j < 16; j++) {
+			size_t x = rand() % buf -> width, y = rand() % buf -> height;
+
+			if(buf -> colour) LSCb_setall(buf, x, y, ' ' + rand() % 95,
+				rand() % 256, rand() % 256);
+
+			else LSCb_set(buf, x, y, ' ' + rand() % 95);
+		}
+
+		present(buf);
+	}
+}
+
+static void present_redraw(LSCb_t *buf, size_t ops) {
+	for(size_t i = 0; i < ops; i++) {
+		LSCb_clear(buf);
+		scene(buf, i / 16);
+		present(buf);
+	}
+}
+
+static void bench_present(const char *name, LSCb_t *buf,
+	void (*function)(LSCb_t *buf, size_t ops))
+{
+	LSCo_init(&out, -1);
+	LSCo_present(&out, buf);
+
+	encoded = 0;
+	function(buf, OPS);
+	const double bytes = encoded / OPS;
+
+	bench_run(name, buf, function, OPS, OPS * buf -> width * buf -> height,
+		bytes);
+
+	LSCo_free(&out);
+}
+
+static int drain(void *arg) {
+	static char chunk[65536];
+	(void) arg;
+
+	while(read(master, chunk, sizeof(chunk)) > 0);
+	return 0;
+}
+
+static int open_pty() {
+	master = posix_openpt(O_RDWR | O_NOCTTY);
+	if(master == -1 || grantpt(master) || unlockpt(master)) return -1;
+
+	int slave = open(ptsname(master), O_RDWR | O_NOCTTY);
+	if(slave == -1) return -1;
+
+	struct termios raw;
+	tcgetattr(slave, &raw);
+	cfmakeraw(&raw);
+	tcsetattr(slave, TCSANOW, &raw);
+
+	return slave;
+}
+
+static void run(const char *name, int fd, LSCb_t *buf) {
+	const double bytes = strlen("\033[1;1H") + strlen(buf -> data);
+
+	fflush(stdout);
+	int saved = dup(STDOUT_FILENO);
+	dup2(fd, STDOUT_FILENO);
+
+	bench_run(name, buf, print, OPS, OPS * buf -> width * buf -> height,
+		bytes);
+
+	fflush(stdout);
+	dup2(saved, STDOUT_FILENO);
+	close(saved);
+}
+
+int main() {
+	bench_group = "frames";
+	bench_out = fdopen(dup(STDOUT_FILENO), "w");
+
+	int null = open("/dev/null", O_WRONLY);
+	if(null == -1) {
+		perror("open");
+		exit(1);
+	}
+
+	int slave = open_pty();
+	if(slave == -1) {
+		perror("pty");
+		exit(1);
+	}
+
+	thrd_t thread;
+	if(thrd_create(&thread, drain, NULL) != thrd_success) {
+		fputs("Error creating pty reader thread.\n", stderr);
+		exit(1);
+	}
+
+	for(size_t i = 0; i < BENCH_SIZES; i++)
+		for(int colour = 0; colour < 2; colour++)
+	{
+		LSCb_t buf;
+		bench_setup(&buf, bench_sizes[i][0], bench_sizes[i][1], colour);
+
+		run("print_null", null, &buf);
+		run("print_pty", slave, &buf);
+
+		bench_present("present_sparse", &buf, present_sparse);
+		bench_present("present_redraw", &buf, present_redraw);
+
+		LSCb_free(&buf);
+	}
+
+	close(slave);
+	thrd_join(thread, NULL);
+
+	close(master);
+	close(null);
+	return 0;
+}
\ No newline at end of file
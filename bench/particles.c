@@ -0,0 +1,110 @@
+/* libScricon: The Simple Graphical Console Library
+ * Copyright (C) 2021-2022 Jyothiraditya Nellakra
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <LSC_buffer.h>
+#include <LSC_error.h>
+#include <LSC_particles.h>
+#include <LSC_random.h>
+
+#include "bench.h"
+
+#define COUNT 65536
+#define FRAMES 64
+
+static LSCp_t ps;
+static LSCr_t rng;
+
+static void spawn(LSCb_t *buf) {
+	LSCr_seed(&rng, BENCH_SEED);
+	ps.count = 0;
+
+	const size_t first = ps.count;
+	const size_t count = LSCp_spawn(&ps, COUNT);
+
+	for(size_t i = first; i < first + count; i++) {
+		ps.x[i] = LSCr_float(&rng) * buf -> width;
+		ps.y[i] = LSCr_float(&rng) * buf -> height;
+		ps.z[i] = -(float) LSCr_below(&rng, 64);
+
+		ps.dx[i] = LSCr_float(&rng) * 2.0f - 1.0f;
+		ps.dy[i] = LSCr_float(&rng) * 4.0f + 1.0f;
+		ps.life[i] = 1.0f + LSCr_below(&rng, 1024);
+
+		ps.chr[i] = ' ' + LSCr_below(&rng, 95);
+		ps.fg[i] = LSCr_below(&rng, 256);
+	}
+}
+
+static void update(LSCb_t *buf, size_t ops) {
+	for(size_t i = 0; i < ops; i++) {
+		LSCp_update(&ps, 0.25f, 0.0f, 0.5f);
+		LSCp_wrap(&ps, buf -> width, buf -> height);
+	}
+}
+
+static void respawn(LSCb_t *buf, size_t ops) {
+	for(size_t i = 0; i < ops; i++) {
+		spawn(buf);
+		LSCp_clip(&ps, buf -> width / 2, buf -> height / 2);
+		LSCp_reap(&ps);
+	}
+}
+
+static void splat(LSCb_t *buf, size_t ops) {
+	for(size_t i = 0; i < ops; i++) LSCp_splat(&ps, buf);
+}
+
+static void splatz(LSCb_t *buf, size_t ops) {
+	for(size_t i = 0; i < ops; i++) LSCp_splatz(&ps, buf);
+}
+
+int main() {
+	bench_group = "particles";
+
+	LSCp_init(&ps);
+	ps.capacity = COUNT;
+
+	if(LSCp_alloc(&ps) != LSCE_OK) {
+		fputs("Error initialising libScricon.\n", stderr);
+		exit(1);
+	}
+
+	for(size_t i = 0; i < BENCH_SIZES; i++)
+		for(int colour = 0; colour < 2; colour++)
+	{
+		LSCb_t buf;
+		bench_setup(&buf, bench_sizes[i][0], bench_sizes[i][1], colour);
+
+		const double cells = (double) FRAMES * COUNT;
+		spawn(&buf);
+
+		bench_run("update", &buf, update, FRAMES, cells, 0);
+		bench_run("splat", &buf, splat, FRAMES, cells, 0);
+		bench_run("splatz", &buf, splatz, FRAMES, cells, 0);
+		bench_run("respawn", &buf, respawn, 1, COUNT, 0);
+
+		LSCb_free(&buf);
+	}
+
+	LSCp_free(&ps);
+	return 0;
+}
@@ -0,0 +1,159 @@
+/* libScricon: The Simple Graphical Console Library
+ * Copyright (C) 2021-2022 Jyothiraditya Nellakra
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <LSC_buffer.h>
+#include <LSC_lines.h>
+#include <LSC_triangles.h>
+
+#include "bench.h"
+
+#define OPS 16384
+
+static size_t xs[3][OPS], ys[3][OPS];
+static double zs[3][OPS];
+
+static char chrs[OPS];
+static uint8_t fgs[OPS], bgs[OPS];
+
+static double line_cells, triangle_cells;
+
+static size_t distance(size_t a, size_t b) {
+	return a > b? a - b: b - a;
+}
+
+static void fill(LSCb_t *buf) {
+	srand(BENCH_SEED);
+	line_cells = triangle_cells = 0;
+
+	for(size_t i = 0; i < OPS; i++) {
+		for(size_t j = 0; j < 3; j++) {
+			xs[j][i] = rand() % buf -> width;
+			ys[j][i] = rand() % buf -> height;
+			zs[j][i] = -buf -> screen - (double) (rand() % 64);
+		}
+
+		chrs[i] = ' ' + rand() % 95;
+		fgs[i] = rand() % 256;
+		bgs[i] = rand() % 256;
+
+		size_t dx = distance(xs[0][i], xs[1][i]);
+		size_t dy = distance(ys[0][i], ys[1][i]);
+		line_cells += (dx > dy? dx: dy) + 1;
+
+		size_t minx = xs[0][i], maxx = xs[0][i];
+		size_t miny = ys[0][i], maxy = ys[0][i];
+
+		for(size_t j = 1; j < 3; j++) {
+			if(xs[j][i] < minx) minx = xs[j][i];
+			if(xs[j][i] > maxx) maxx = xs[j][i];
+			if(ys[j][i] < miny) miny = ys[j][i];
+			if(ys[j][i] > maxy) maxy = ys[j][i];
+		}
+
+		triangle_cells += (maxx - minx) * (maxy - miny);
+	}
+}
+
+static void lines_set(LSCb_t *buf, size_t ops) {
+	for(size_t i = 0; i < ops; i++) LSCl_set(buf, xs[0][i], ys[0][i],
+		xs[1][i], ys[1][i], chrs[i]);
+}
+
+static void lines_draw(LSCb_t *buf, size_t ops) {
+	for(size_t i = 0; i < ops; i++) LSCl_draw(buf, xs[0][i], ys[0][i],
+		xs[1][i], ys[1][i]);
+}
+
+static void lines_setall(LSCb_t *buf, size_t ops) {
+	for(size_t i = 0; i < ops; i++) LSCl_setall(buf, xs[0][i], ys[0][i],
+		xs[1][i], ys[1][i], chrs[i], fgs[i], bgs[i]);
+}
+
+static void lines_setz(LSCb_t *buf, size_t ops) {
+	for(size_t i = 0; i < ops; i++) LSCl_setz(buf, xs[0][i], ys[0][i],
+		zs[0][i], xs[1][i], ys[1][i], zs[1][i], chrs[i]);
+}
+
+static void lines_drawz(LSCb_t *buf, size_t ops) {
+	for(size_t i = 0; i < ops; i++) LSCl_drawz(buf, xs[0][i], ys[0][i],
+		zs[0][i], xs[1][i], ys[1][i], zs[1][i]);
+}
+
+static void triangles_set(LSCb_t *buf, size_t ops) {
+	for(size_t i = 0; i < ops; i++) LSCt_set(buf, xs[0][i], ys[0][i],
+		xs[1][i], ys[1][i], xs[2][i], ys[2][i], chrs[i]);
+}
+
+static void triangles_setall(LSCb_t *buf, size_t ops) {
+	for(size_t i = 0; i < ops; i++) LSCt_setall(buf, xs[0][i], ys[0][i],
+		xs[1][i], ys[1][i], xs[2][i], ys[2][i], chrs[i],
+		fgs[i], bgs[i]);
+}
+
+static void triangles_setz(LSCb_t *buf, size_t ops) {
+	for(size_t i = 0; i < ops; i++) LSCt_setz(buf, xs[0][i], ys[0][i],
+		zs[0][i], xs[1][i], ys[1][i], zs[1][i], xs[2][i], ys[2][i],
+		zs[2][i], chrs[i]);
+}
+
+static void triangles_setallz(LSCb_t *buf, size_t ops) {
+	for(size_t i = 0; i < ops; i++) LSCt_setallz(buf, xs[0][i], ys[0][i],
+		zs[0][i], xs[1][i], ys[1][i], zs[1][i], xs[2][i], ys[2][i],
+		zs[2][i], chrs[i], fgs[i], bgs[i]);
+}
+
+int main() {
+	bench_group = "raster";
+
+	for(size_t i = 0; i < BENCH_SIZES; i++)
+		for(int colour = 0; colour < 2; colour++)
+	{
+		LSCb_t buf;
+		bench_setup(&buf, bench_sizes[i][0], bench_sizes[i][1], colour);
+		fill(&buf);
+
+		bench_run("lines_set", &buf, lines_set, OPS, line_cells, 0);
+		bench_run("lines_draw", &buf, lines_draw, OPS, line_cells, 0);
+		bench_run("lines_setz", &buf, lines_setz, OPS, line_cells, 0);
+		bench_run("lines_drawz", &buf, lines_drawz, OPS, line_cells, 0);
+
+		bench_run("triangles_set", &buf, triangles_set, OPS,
+			triangle_cells, 0);
+
+		bench_run("triangles_setz", &buf, triangles_setz, OPS,
+			triangle_cells, 0);
+
+		if(colour) {
+			bench_run("lines_setall", &buf, lines_setall, OPS,
+				line_cells, 0);
+
+			bench_run("triangles_setall", &buf, triangles_setall,
+				OPS, triangle_cells, 0);
+
+			bench_run("triangles_setallz", &buf, triangles_setallz,
+				OPS, triangle_cells, 0);
+		}
+
+		LSCb_free(&buf);
+	}
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,147 @@
+/* libScricon: The Simple Graphical Console Library
+ * Copyright (C) 2021-2022 Jyothiraditya Nellakra
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <LSC_buffer.h>
+#include <LSC_random.h>
+#include <LSC_scrolling.h>
+
+#include "bench.h"
+
+#define OPS 1048576
+#define FULL_OPS 64
+
+static size_t xs[OPS], ys[OPS];
+static double zs[OPS];
+
+static char chrs[OPS];
+static uint8_t fgs[OPS], bgs[OPS];
+
+static const LSCr_pick_t pick = {chrs, 95, fgs, 256, bgs, 256};
+
+static void fill(LSCb_t *buf) {
+	srand(BENCH_SEED);
+
+	for(size_t i = 0; i < OPS; i++) {
+		xs[i] = rand() % buf -> width;
+		ys[i] = rand() % buf -> height;
+		zs[i] = -(double) (rand() % 64);
+
+		chrs[i] = ' ' + rand() % 95;
+		fgs[i] = rand() % 256;
+		bgs[i] = rand() % 256;
+	}
+}
+
+static void set(LSCb_t *buf, size_t ops) {
+	for(size_t i = 0; i < ops; i++) LSCb_set(buf, xs[i], ys[i], chrs[i]);
+}
+
+static void setv(LSCb_t *buf, size_t ops) {
+	for(size_t i = 0; i < ops; i++)
+		LSCb_setv(buf, xs[i] * 2, ys[i] * 2, chrs[i]);
+}
+
+static void setz(LSCb_t *buf, size_t ops) {
+	for(size_t i = 0; i < ops; i++)
+		LSCb_setz(buf, xs[i], ys[i], zs[i], chrs[i]);
+}
+
+static void setcol(LSCb_t *buf, size_t ops) {
+	for(size_t i = 0; i < ops; i++)
+		LSCb_setcol(buf, xs[i], ys[i], fgs[i], bgs[i]);
+}
+
+static void setfg(LSCb_t *buf, size_t ops) {
+	for(size_t i = 0; i < ops; i++) LSCb_setfg(buf, xs[i], ys[i], fgs[i]);
+}
+
+static void setbg(LSCb_t *buf, size_t ops) {
+	for(size_t i = 0; i < ops; i++) LSCb_setbg(buf, xs[i], ys[i], bgs[i]);
+}
+
+static void setall(LSCb_t *buf, size_t ops) {
+	for(size_t i = 0; i < ops; i++)
+		LSCb_setall(buf, xs[i], ys[i], chrs[i], fgs[i], bgs[i]);
+}
+
+static void setallz(LSCb_t *buf, size_t ops) {
+	for(size_t i = 0; i < ops; i++) LSCb_setallz(buf, xs[i], ys[i], zs[i],
+		chrs[i], fgs[i], bgs[i]);
+}
+
+static void random_fill(LSCb_t *buf, size_t ops) {
+	LSCr_t rng;
+	LSCr_seed(&rng, BENCH_SEED);
+
+	for(size_t i = 0; i < ops; i++)
+		LSCr_fill(&rng, buf, 0, buf -> height, &pick);
+}
+
+static void random_scatter(LSCb_t *buf, size_t ops) {
+	LSCr_t rng;
+	LSCr_seed(&rng, BENCH_SEED);
+	LSCr_scatter(&rng, buf, ops, &pick);
+}
+
+static void clear(LSCb_t *buf, size_t ops) {
+	for(size_t i = 0; i < ops; i++) LSCb_clear(buf);
+}
+
+static void scroll(LSCb_t *buf, size_t ops) {
+	for(size_t i = 0; i < ops; i++) LSC_scrollv(buf, i % 2? 1: -1);
+}
+
+int main() {
+	bench_group = "setters";
+
+	for(size_t i = 0; i < BENCH_SIZES; i++)
+		for(int colour = 0; colour < 2; colour++)
+	{
+		LSCb_t buf;
+		bench_setup(&buf, bench_sizes[i][0], bench_sizes[i][1], colour);
+
+		const double cells = buf.width * buf.height;
+		fill(&buf);
+
+		bench_run("set", &buf, set, OPS, OPS, 0);
+		bench_run("setv", &buf, setv, OPS, OPS, 0);
+		bench_run("setz", &buf, setz, OPS, OPS, 0);
+
+		if(colour) {
+			bench_run("setcol", &buf, setcol, OPS, OPS, 0);
+			bench_run("setfg", &buf, setfg, OPS, OPS, 0);
+			bench_run("setbg", &buf, setbg, OPS, OPS, 0);
+			bench_run("setall", &buf, setall, OPS, OPS, 0);
+			bench_run("setallz", &buf, setallz, OPS, OPS, 0);
+		}
+
+		bench_run("fill", &buf, random_fill, FULL_OPS,
+			FULL_OPS * cells, 0);
+
+		bench_run("scatter", &buf, random_scatter, OPS, OPS, 0);
+		bench_run("clear", &buf, clear, FULL_OPS, FULL_OPS * cells, 0);
+		bench_run("scroll", &buf, scroll, FULL_OPS, FULL_OPS * cells, 0);
+
+		LSCb_free(&buf);
+	}
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,460 @@
+/* libScricon: The Simple Graphical Console Library
+ * Copyright (C) 2021-2022 Jyothiraditya Nellakra
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#include <errno.h>
+#include <float.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <signal.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <LC_args.h>
+#include <LC_vars.h>
+
+#include <LSC_buffer.h>
+#include <LSC_colour.h>
+#include <LSC_error.h>
+#include <LSC_particles.h>
+#include <LSC_random.h>
+#include <LSC_terminal.h>
+
+const char *name;
+LSCb_t buffer;
+LSCp_t particles;
+LSCr_t rng;
+
+struct termios cooked, raw;
+size_t height, width;
+
+char mode[16];
+bool rain;
+
+size_t len_chrs;
+char chrs[256];
+
+size_t len_fgs;
+uint8_t fgs[256];
+
+uint8_t bg;
+char blank[24];
+
+bool colour;
+bool running = true;
+
+bool headless, quiet;
+char size[32];
+
+size_t frames, seed;
+
+size_t frame;
+uint64_t total_ns, min_ns = UINT64_MAX, max_ns;
+
+size_t delay = 1;
+double density = 0.1;
+double speed = 1.0;
+double lifetime = 60.0;
+
+void init(int argc, char **argv);
+void on_interrupt(int signum);
+void present();
+
+void mkdelay() {
+	struct timespec ts;
+	int ret;
+
+	ts.tv_sec = delay / 1000;
+	ts.tv_nsec = (delay % 1000) * 1000000;
+
+	do ret = nanosleep(&ts, &ts);
+	while (ret && errno == EINTR);
+}
+
+/* Rain drops start in the top row and fall at up to one and a half times the
+ * speed until they leave the screen. Stars sit still and go through the
+ * foreground colours over their lifetime, so the list reads as a twinkle from
+ * start to finish; the first ones are lit part of the way through it. */
+
+void spawn(size_t count) {
+	const size_t first = particles.count;
+	count = LSCp_spawn(&particles, count);
+
+	for(size_t i = first; i < first + count; i++) {
+		particles.x[i] = LSCr_float(&rng) * buffer.width;
+		particles.chr[i] = chrs[LSCr_below(&rng, len_chrs)];
+
+		if(rain) {
+			particles.y[i] = LSCr_float(&rng);
+			particles.dy[i] = speed * (0.5f + LSCr_float(&rng));
+			particles.life[i] = FLT_MAX;
+			particles.fg[i] = fgs[LSCr_below(&rng, len_fgs)];
+		}
+
+		else {
+			particles.y[i] = LSCr_float(&rng) * buffer.height;
+			particles.life[i] = frame? lifetime:
+				lifetime * (1.0f - LSCr_float(&rng));
+		}
+	}
+}
+
+void twinkle() {
+	for(size_t i = 0; i < particles.count; i++) {
+		size_t j = (1.0 - particles.life[i] / lifetime) * len_fgs;
+		particles.fg[i] = fgs[j < len_fgs? j: len_fgs - 1];
+	}
+}
+
+void engine() {
+	present();
+	LSCp_update(&particles, 1.0f, 0.0f, 0.0f);
+
+	if(rain) {
+		LSCp_clip(&particles, buffer.width, buffer.height);
+		LSCp_reap(&particles);
+		spawn(buffer.width * density);
+	}
+
+	else {
+		LSCp_reap(&particles);
+		size_t lit = buffer.width * buffer.height * density;
+		if(lit > particles.count) spawn(lit - particles.count);
+		twinkle();
+	}
+
+	LSCb_clear(&buffer);
+	LSCp_splat(&particles, &buffer);
+}
+
+void init_tty() {
+	int ret = tcgetattr(STDIN_FILENO, &cooked);
+	if(ret == -1) {
+		puts("Error getting terminal properties with tcgetattr().");
+		exit(1);
+	}
+
+	raw = cooked;
+	raw.c_lflag &= ~(ICANON | ECHO);
+
+	ret = tcsetattr(STDIN_FILENO, TCSANOW, &raw);
+	if(ret == -1) {
+		puts("Error setting terminal properties with tcsetattr().");
+		exit(2);
+	}
+
+	ret = LSC_winsize(STDOUT_FILENO, &width, &height);
+	if(ret != LSCE_OK) {
+		tcsetattr(STDIN_FILENO, TCSANOW, &cooked);
+		puts("Error getting screen size with TIOCGWINSZ.");
+		exit(3);
+	}
+
+	LSC_winch();
+
+	printf("\033[?25l");
+}
+
+void exit_tty() {
+	if(headless) return;
+
+	tcsetattr(STDIN_FILENO, TCSANOW, &cooked);
+	printf("\033[?25h");
+}
+
+void resize() {
+	if(headless || !LSC_resized()) return;
+
+	int ret = LSC_winsize(STDOUT_FILENO, &width, &height);
+	if(ret != LSCE_OK) return;
+
+	ret = LSCb_resize(&buffer, width, height);
+	if(ret != LSCE_OK) {
+		running = false;
+		return;
+	}
+
+	LSCp_clip(&particles, buffer.width, buffer.height);
+	LSCp_reap(&particles);
+	printf("\033[2J");
+}
+
+uint64_t now() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+void present() {
+	if(!headless) {
+		LSCb_print(&buffer, 1);
+		mkdelay();
+		return;
+	}
+
+	LSCb_write(&buffer, quiet? -1: STDOUT_FILENO, 1);
+}
+
+void record(uint64_t ns) {
+	frame++;
+	total_ns += ns;
+
+	if(ns < min_ns) min_ns = ns;
+	if(ns > max_ns) max_ns = ns;
+}
+
+void report() {
+	if(!frame) return;
+
+	double secs = total_ns / 1e9;
+	double cells = (double) buffer.width * buffer.height * frame;
+	double bytes = (double) buffer.chwidth * buffer.width
+		* buffer.height * frame;
+
+	fprintf(stderr, "%zu frames of %zux%zu in %.3f s\n", frame,
+		buffer.width, buffer.height, secs);
+
+	fprintf(stderr, "frame time: %.3f ms avg, %.3f ms min, %.3f ms max\n",
+		total_ns / 1e6 / frame, min_ns / 1e6, max_ns / 1e6);
+
+	fprintf(stderr, "throughput: %.1f fps, %.0f cells/s, %.2f MB/s\n",
+		frame / secs, cells / secs, bytes / secs / 1e6);
+}
+
+int main(int argc, char **argv) {
+	name = argv[0];
+	init(argc, argv);
+
+	signal(SIGINT, on_interrupt);
+
+	if(!headless) init_tty();
+	LSCb_init(&buffer);
+
+	buffer.colour = colour;
+	buffer.height = height;
+	buffer.width = width;
+
+	LSCc_col(blank, 15, bg);
+	blank[22] = ' ';
+	if(colour) buffer.cchs = blank;
+
+	int ret = LSCb_alloc(&buffer);
+	if(ret != LSCE_OK) {
+		exit_tty();
+		puts("Error initialising libScricon.");
+		exit(4);
+	}
+
+	LSCp_init(&particles);
+	particles.capacity = width * height + width;
+
+	ret = LSCp_alloc(&particles);
+	if(ret != LSCE_OK) {
+		exit_tty();
+		puts("Error initialising libScricon.");
+		exit(4);
+	}
+
+	LSCr_seed(&rng, seed);
+	LSCb_clear(&buffer);
+
+	while(running && (!frames || frame < frames)) {
+		resize();
+		uint64_t start = now();
+		engine();
+		record(now() - start);
+	}
+
+	exit_tty();
+	if(headless) report();
+
+	LSCp_free(&particles);
+	LSCb_free(&buffer);
+	return 0;
+}
+
+void about() {
+	putchar('\n');
+	puts("  libScricon: The Simple Graphical Console Library");
+	puts("  Copyright (C) 2021-2022 Jyothiraditya Nellakra");
+	puts("  Particle System Demonstration\n");
+
+	puts("  This program is free software: you can redistribute it and/or modify");
+	puts("  it under the terms of the GNU General Public License as published by");
+	puts("  the Free Software Foundation, either version 3 of the License, or");
+	puts("  (at your option) any later version.\n");
+
+	puts("  This program is distributed in the hope that it will be useful,");
+	puts("  but WITHOUT ANY WARRANTY; without even the implied warranty of");
+	puts("  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the");
+	puts("  GNU General Public License for more details.\n");
+
+	puts("  You should have received a copy of the GNU General Public License");
+	puts("  along with this program. If not, see <https://www.gnu.org/licenses/>.\n");
+
+	exit(0);
+}
+
+void help(int ret) {
+	putchar('\n');
+	printf("  Usage: %s [OPTIONS]\n\n", name);
+
+	puts("  Valid options are:");
+	puts("    -a, --about             print the about dialogue");
+	puts("    -h, --help              print this help dialogue\n");
+
+	puts("    -m, --mode MODE         draw rain or stars (the default)");
+	puts("    -c, --chrs CHRS         set the characters to use");
+	puts("    -f, --fgs FGS           set the foreground colours to use");
+	puts("    -b, --bg BG             set the background colour\n");
+
+	puts("    -C, --colour            enable colour output");
+	puts("    -d, --delay MILLISECS   the length of time to delay printing");
+	puts("    -x, --density FRAC      the number of drops spawned per frame as a fraction");
+	puts("                            of the width, or of stars lit as a fraction of the");
+	puts("                            total number of characters.");
+	puts("    -v, --speed CELLS       the average number of rows a drop falls per frame");
+	puts("    -l, --lifetime FRAMES   the average number of frames a star is lit for\n");
+
+	puts("    -F, --frames N          stop after drawing N frames");
+	puts("    -G, --size WxH          render headless at the given size without a terminal");
+	puts("    -R, --seed S            set the random seed");
+	puts("    -q, --quiet             discard headless output instead of writing it\n");
+
+	puts("  Note: CHRS is a single-string argument. FGS is a list of integers separated");
+	puts("        by spaces, which stars go through in order as they fade.\n");
+
+	puts("  Happy coding! :)\n");
+	exit(ret);
+}
+
+void help_flag() {
+	help(0);
+}
+
+void init(int argc, char **argv) {
+	LCa_t *arg = LCa_new(); arg -> long_flag = "about";
+	arg -> short_flag = 'a'; arg -> pre = about;
+	arg = LCa_new(); arg -> long_flag = "help";
+	arg -> short_flag = 'h'; arg -> pre = help_flag;
+
+	LCv_t *var = LCv_new(); var -> id = "mode";
+	var -> fmt = "%15c"; var -> data = mode;
+	arg = LCa_new(); arg -> long_flag = "mode";
+	arg -> short_flag = 'm'; arg -> var = var;
+
+	var = LCv_new(); var -> id = "chrs";
+	var -> fmt = "%95c"; var -> data = chrs;
+	arg = LCa_new(); arg -> long_flag = "chrs";
+	arg -> short_flag = 'c'; arg -> var = var;
+
+	var = LCv_new(); var -> id = "fgs"; var -> fmt = "%" SCNu8;
+	var -> data = fgs; var -> len = &len_fgs; var -> min_len = 0;
+	var -> max_len = 256; var -> size = sizeof(uint8_t);
+	arg = LCa_new(); arg -> long_flag = "fgs";
+	arg -> short_flag = 'f'; arg -> var = var;
+
+	var = LCv_new(); var -> id = "bg";
+	var -> fmt = "%" SCNu8; var -> data = &bg;
+	arg = LCa_new(); arg -> long_flag = "bg";
+	arg -> short_flag = 'b'; arg -> var = var;
+
+	var = LCv_new(); var -> id = "colour"; var -> data = &colour;
+	arg = LCa_new(); arg -> long_flag = "colour"; arg -> short_flag = 'C';
+	arg -> var = var; arg -> value = true;
+
+	var = LCv_new(); var -> id = "delay";
+	var -> fmt = "%zu"; var -> data = &delay;
+	arg = LCa_new(); arg -> long_flag = "delay";
+	arg -> short_flag = 'd'; arg -> var = var;
+
+	var = LCv_new(); var -> id = "density";
+	var -> fmt = "%lf"; var -> data = &density;
+	arg = LCa_new(); arg -> long_flag = "density";
+	arg -> short_flag = 'x'; arg -> var = var;
+
+	var = LCv_new(); var -> id = "speed";
+	var -> fmt = "%lf"; var -> data = &speed;
+	arg = LCa_new(); arg -> long_flag = "speed";
+	arg -> short_flag = 'v'; arg -> var = var;
+
+	var = LCv_new(); var -> id = "lifetime";
+	var -> fmt = "%lf"; var -> data = &lifetime;
+	arg = LCa_new(); arg -> long_flag = "lifetime";
+	arg -> short_flag = 'l'; arg -> var = var;
+
+	var = LCv_new(); var -> id = "frames";
+	var -> fmt = "%zu"; var -> data = &frames;
+	arg = LCa_new(); arg -> long_flag = "frames";
+	arg -> short_flag = 'F'; arg -> var = var;
+
+	var = LCv_new(); var -> id = "size";
+	var -> fmt = "%31c"; var -> data = size;
+	arg = LCa_new(); arg -> long_flag = "size";
+	arg -> short_flag = 'G'; arg -> var = var;
+
+	var = LCv_new(); var -> id = "seed";
+	var -> fmt = "%zu"; var -> data = &seed;
+	arg = LCa_new(); arg -> long_flag = "seed";
+	arg -> short_flag = 'R'; arg -> var = var;
+
+	var = LCv_new(); var -> id = "quiet"; var -> data = &quiet;
+	arg = LCa_new(); arg -> long_flag = "quiet"; arg -> short_flag = 'q';
+	arg -> var = var; arg -> value = true;
+
+	seed = time(NULL);
+
+	int ret = LCa_read(argc, argv);
+	if(ret != LCA_OK) help(1);
+
+	if(!strcmp(mode, "rain")) rain = true;
+	else if(strlen(mode) && strcmp(mode, "stars")) help(1);
+
+	if(density < 0.0 || density > 1.0 || speed <= 0.0 || lifetime <= 0.0)
+		help(1);
+
+	headless = strlen(size);
+	if(headless) {
+		ret = sscanf(size, "%zux%zu", &width, &height);
+		if(ret != 2 || !width || !height) help(1);
+	}
+
+	len_chrs = strlen(chrs);
+	if(!len_chrs) {
+		for(uint8_t i = '!'; i <= '~'; i++) chrs[i - '!'] = i;
+		len_chrs = '~' - '!' + 1;
+	}
+
+	if(!len_fgs) {
+		for(size_t i = 0; i < 256; i++) fgs[i] = i;
+		len_fgs = 256;
+	}
+}
+
+void on_interrupt(int signum) {
+	if(signum != SIGINT) {
+		signal(signum, SIG_DFL);
+		return;
+	}
+
+	running = false;
+}
@@ -16,9 +16,9 @@
 # You should have received a copy of the GNU General Public License along with
 # this program. If not, see <https://www.gnu.org/licenses/>.
 
-chrs=".,/:;'!{[(                      ";
+chrs=".,/:;'!{[(";
 fgs="17 18 19 20 21 25 26 27 32 33";
-bgs="232 233 234"
+bg="232"
 
 case "$1" in
 "-about")
@@ -71,8 +71,8 @@ case "$1" in
 		exit 1
 	fi
 
-	make rand_chars
-	./rand_chars -Cc "$chrs" -f $fgs -b $bgs -d "$delay" -s 0.05 -x 0
+	make particles
+	./particles -m rain -Cc "$chrs" -f $fgs -b $bg -d "$delay" -x 0.3
 ;;
 
 *)
@@ -89,7 +89,7 @@ case "$1" in
 		exit 1
 	fi
 
-	make rand_chars
-	./rand_chars -c "$chrs" -d "$delay" -s 0.05 -x 0
+	make particles
+	./particles -m rain -c "$chrs" -d "$delay" -x 0.3
 ;;
 esac
\ No newline at end of file
@@ -34,10 +34,13 @@
 
 #include <LSC_buffer.h>
 #include <LSC_error.h>
+#include <LSC_random.h>
 #include <LSC_scrolling.h>
+#include <LSC_terminal.h>
 
 const char *name;
 LSCb_t buffer;
+LSCr_t rng;
 
 struct termios cooked, raw;
 size_t height, width;
@@ -51,9 +54,19 @@ uint8_t fgs[256];
 size_t len_bgs;
 uint8_t bgs[256];
 
+LSCr_pick_t pick, fg_pick, bg_pick, chr_pick;
+
 bool colour;
 bool running = true;
 
+bool headless, quiet;
+char size[32];
+
+size_t frames, seed;
+
+size_t frame;
+uint64_t total_ns, min_ns = UINT64_MAX, max_ns;
+
 size_t delay = 1;
 double change = 0.1;
 
@@ -63,29 +76,15 @@ size_t scroll_delay;
 
 void init(int argc, char **argv);
 void on_interrupt(int signum);
+void present();
 
 void refill() {
 	intmax_t lines = imaxabs(scroll_rows);
 
-	if(scroll_rows < 0)
-		for(size_t i = buffer.height - lines; i < buffer.height; i++)
-		for(size_t j = 0; j < buffer.width; j++)
-	{
-		if(colour) LSCb_setall(&buffer, j, i, chrs[rand() % len_chrs],
-			fgs[rand() % len_fgs], bgs[rand() % len_bgs]);
-
-		else LSCb_set(&buffer, j, i, chrs[rand() % len_chrs]);
-	}
-
-	else if(scroll_rows > 0)
-		for(intmax_t i = 0; i < lines; i++)
-		for(size_t j = 0; j < buffer.width; j++)
-	{
-		if(colour) LSCb_setall(&buffer, j, i, chrs[rand() % len_chrs],
-			fgs[rand() % len_fgs], bgs[rand() % len_bgs]);
+	if(scroll_rows < 0) LSCr_fill(&rng, &buffer,
+		buffer.height - lines, lines, &pick);
 
-		else LSCb_set(&buffer, j, i, chrs[rand() % len_chrs]);
-	}
+	else if(scroll_rows > 0) LSCr_fill(&rng, &buffer, 0, lines, &pick);
 }
 
 void mkdelay() {
@@ -103,23 +102,15 @@ void engine() {
 	size_t step = 0;
 	size_t count = fabs(buffer.width * buffer.height * change);
 
-	LSCb_print(&buffer, 1);
-	mkdelay();
-
-	for(size_t i = 0; i < count; i++) {
-		if(colour && len_fgs) LSCb_setfg(&buffer,
-			rand() % buffer.width, rand() % buffer.height,
-			fgs[rand() % len_fgs]);
-
-		if(colour && len_bgs) LSCb_setbg(&buffer,
-			rand() % buffer.width, rand() % buffer.height,
-			bgs[rand() % len_bgs]);
+	present();
 
-		if(len_chrs) LSCb_set(&buffer,
-			rand() % buffer.width, rand() % buffer.height,
-			chrs[rand() % len_chrs]);
+	if(colour) {
+		LSCr_scatter(&rng, &buffer, count, &fg_pick);
+		LSCr_scatter(&rng, &buffer, count, &bg_pick);
 	}
 
+	LSCr_scatter(&rng, &buffer, count, &chr_pick);
+
 	if(step == scroll_delay) {
 		LSC_scrollv(&buffer, scroll_rows);
 		refill();
@@ -129,12 +120,7 @@ void engine() {
 	else step++;
 }
 
-int main(int argc, char **argv) {
-	name = argv[0];
-	init(argc, argv);
-
-	signal(SIGINT, on_interrupt);
-
+void init_tty() {
 	int ret = tcgetattr(STDIN_FILENO, &cooked);
 	if(ret == -1) {
 		puts("Error getting terminal properties with tcgetattr().");
@@ -150,49 +136,122 @@ int main(int argc, char **argv) {
 		exit(2);
 	}
 
-	printf("\033[999;999H\033[6n");
-	while(getchar() != '\033');
-
-	ret = scanf("[%zu;%zuR", &height, &width);
-	if(ret != 2) {
+	ret = LSC_winsize(STDOUT_FILENO, &width, &height);
+	if(ret != LSCE_OK) {
 		tcsetattr(STDIN_FILENO, TCSANOW, &cooked);
-		puts("Error getting screen size with ANSI escape codes.");
+		puts("Error getting screen size with TIOCGWINSZ.");
 		exit(3);
 	}
 
+	LSC_winch();
+
 	printf("\033[?25l");
+}
+
+void exit_tty() {
+	if(headless) return;
+
+	tcsetattr(STDIN_FILENO, TCSANOW, &cooked);
+	printf("\033[?25h");
+}
+
+void resize() {
+	if(headless || !LSC_resized()) return;
+
+	int ret = LSC_winsize(STDOUT_FILENO, &width, &height);
+	if(ret != LSCE_OK) return;
+
+	ret = LSCb_resize(&buffer, width, height);
+	if(ret != LSCE_OK) {
+		running = false;
+		return;
+	}
+
+	scroll_rows = buffer.height * scroll;
+	printf("\033[2J");
+}
+
+uint64_t now() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+void present() {
+	if(!headless) {
+		LSCb_print(&buffer, 1);
+		mkdelay();
+		return;
+	}
+
+	LSCb_write(&buffer, quiet? -1: STDOUT_FILENO, 1);
+}
+
+void record(uint64_t ns) {
+	frame++;
+	total_ns += ns;
+
+	if(ns < min_ns) min_ns = ns;
+	if(ns > max_ns) max_ns = ns;
+}
+
+void report() {
+	if(!frame) return;
+
+	double secs = total_ns / 1e9;
+	double cells = (double) buffer.width * buffer.height * frame;
+	double bytes = (double) buffer.chwidth * buffer.width
+		* buffer.height * frame;
+
+	fprintf(stderr, "%zu frames of %zux%zu in %.3f s\n", frame,
+		buffer.width, buffer.height, secs);
+
+	fprintf(stderr, "frame time: %.3f ms avg, %.3f ms min, %.3f ms max\n",
+		total_ns / 1e6 / frame, min_ns / 1e6, max_ns / 1e6);
+
+	fprintf(stderr, "throughput: %.1f fps, %.0f cells/s, %.2f MB/s\n",
+		frame / secs, cells / secs, bytes / secs / 1e6);
+}
+
+int main(int argc, char **argv) {
+	name = argv[0];
+	init(argc, argv);
+
+	signal(SIGINT, on_interrupt);
+
+	if(!headless) init_tty();
 	LSCb_init(&buffer);
 
 	buffer.colour = colour;
 	buffer.height = height;
 	buffer.width = width;
 
-	ret = LSCb_alloc(&buffer);
+	int ret = LSCb_alloc(&buffer);
 	if(ret != LSCE_OK) {
-		tcsetattr(STDIN_FILENO, TCSANOW, &cooked);
+		exit_tty();
 		puts("Error initialising libScricon.");
-		printf("\033[?25h");
 		exit(4);
 	}
 
-	srand(time(NULL));
+	LSCr_seed(&rng, seed);
 
-	for(size_t i = 0; i < buffer.width; i++)
-		for(size_t j = 0; j < buffer.height; j++)
-	{
-		if(colour) LSCb_setall(&buffer, i, j,
-			chrs[rand() % len_chrs],
-			fgs[rand() % len_fgs],
-			bgs[rand() % len_bgs]);
+	pick = (LSCr_pick_t) {chrs, len_chrs, fgs, len_fgs, bgs, len_bgs};
+	fg_pick = (LSCr_pick_t) {NULL, 0, fgs, len_fgs, NULL, 0};
+	bg_pick = (LSCr_pick_t) {NULL, 0, NULL, 0, bgs, len_bgs};
+	chr_pick = (LSCr_pick_t) {chrs, len_chrs, NULL, 0, NULL, 0};
 
-		else LSCb_set(&buffer, i, j, chrs[rand() % len_chrs]);
-	}
+	LSCr_fill(&rng, &buffer, 0, buffer.height, &pick);
 
 	scroll_rows = buffer.height * scroll;
-	while(running) engine();
+	while(running && (!frames || frame < frames)) {
+		resize();
+		uint64_t start = now();
+		engine();
+		record(now() - start);
+	}
 
-	tcsetattr(STDIN_FILENO, TCSANOW, &cooked);
-	printf("\033[?25h");
+	exit_tty();
+	if(headless) report();
 	return 0;
 }
 
@@ -239,6 +298,11 @@ void help(int ret) {
 	puts("                            (if positive) as a fraction of the screen height.");
 	puts("    -S, --scroll-delay DLY  number of frames to wait to scroll the screen.\n");
 
+	puts("    -F, --frames N          stop after drawing N frames");
+	puts("    -G, --size WxH          render headless at the given size without a terminal");
+	puts("    -R, --seed S            set the random seed");
+	puts("    -q, --quiet             discard headless output instead of writing it\n");
+
 	puts("  Note: CHRS is a single-string argument. FGS and BGS are a list of integers");
 	puts("        separated by spaces. FRAC and ROWS are doubles between 0.0 and 1.0.\n");
 
@@ -297,9 +361,36 @@ void init(int argc, char **argv) {
 	arg = LCa_new(); arg -> long_flag = "scroll-delay";
 	arg -> short_flag = 'S'; arg -> var = var;
 
+	var = LCv_new(); var -> id = "frames";
+	var -> fmt = "%zu"; var -> data = &frames;
+	arg = LCa_new(); arg -> long_flag = "frames";
+	arg -> short_flag = 'F'; arg -> var = var;
+
+	var = LCv_new(); var -> id = "size";
+	var -> fmt = "%31c"; var -> data = size;
+	arg = LCa_new(); arg -> long_flag = "size";
+	arg -> short_flag = 'G'; arg -> var = var;
+
+	var = LCv_new(); var -> id = "seed";
+	var -> fmt = "%zu"; var -> data = &seed;
+	arg = LCa_new(); arg -> long_flag = "seed";
+	arg -> short_flag = 'R'; arg -> var = var;
+
+	var = LCv_new(); var -> id = "quiet"; var -> data = &quiet;
+	arg = LCa_new(); arg -> long_flag = "quiet"; arg -> short_flag = 'q';
+	arg -> var = var; arg -> value = true;
+
+	seed = time(NULL);
+
 	int ret = LCa_read(argc, argv);
 	if(ret != LCA_OK) help(1);
 
+	headless = strlen(size);
+	if(headless) {
+		ret = sscanf(size, "%zux%zu", &width, &height);
+		if(ret != 2 || !width || !height) help(1);
+	}
+
 	len_chrs = strlen(chrs);
 	if(!len_chrs) {
 		for(uint8_t i = ' '; i <= '~'; i++) chrs[i - ' '] = i;
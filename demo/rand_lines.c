@@ -35,9 +35,12 @@
 #include <LSC_buffer.h>
 #include <LSC_error.h>
 #include <LSC_lines.h>
+#include <LSC_random.h>
+#include <LSC_terminal.h>
 
 const char *name;
 LSCb_t buffer;
+LSCr_t rng;
 
 struct termios cooked, raw;
 size_t height, width, depth;
@@ -54,11 +57,20 @@ uint8_t bgs[256];
 bool colour, three_d;
 bool running = true;
 
+bool headless, quiet;
+char size[32];
+
+size_t frames, seed;
+
+size_t frame;
+uint64_t total_ns, min_ns = UINT64_MAX, max_ns;
+
 size_t count = 1;
 size_t delay = 1;
 
 void init(int argc, char **argv);
 void on_interrupt(int signum);
+void present();
 
 void mkdelay() {
 	struct timespec ts;
@@ -72,55 +84,52 @@ void mkdelay() {
 }
 
 void engine_2d() {
-	LSCb_print(&buffer, 1);
-	mkdelay();
+	present();
 
 	for(size_t i = 0; i < count; i++) {
-		size_t x1 = rand() % buffer.width, x2 = rand() % buffer.width;
-		size_t y1 = rand() % buffer.height, y2 = rand() % buffer.height;
+		size_t x1 = LSCr_below(&rng, buffer.width);
+		size_t x2 = LSCr_below(&rng, buffer.width);
+		size_t y1 = LSCr_below(&rng, buffer.height);
+		size_t y2 = LSCr_below(&rng, buffer.height);
 		
 		if(colour && len_fgs) LSCl_setfg(&buffer, x1, y1, x2, y2,
-			fgs[rand() % len_fgs]);
+			fgs[LSCr_below(&rng, len_fgs)]);
 
 		if(colour && len_bgs) LSCl_setbg(&buffer, x1, y1, x2, y2,
-			bgs[rand() % len_bgs]);
+			bgs[LSCr_below(&rng, len_bgs)]);
 
 		if(len_chrs) LSCl_set(&buffer, x1, y1, x2, y2,
-			chrs[rand() % len_chrs]);
+			chrs[LSCr_below(&rng, len_chrs)]);
 
 		else LSCl_draw(&buffer, x1, y1, x2, y2);
 	}
 }
 
 void engine_3d() {
-	LSCb_print(&buffer, 1);
-	mkdelay();
+	present();
 
 	for(size_t i = 0; i < count; i++) {
-		size_t x1 = rand() % buffer.width, x2 = rand() % buffer.width;
-		size_t y1 = rand() % buffer.height, y2 = rand() % buffer.height;
-		double z1 = -buffer.screen - (double) (rand() % depth);
-		double z2 = -buffer.screen - (double) (rand() % depth);
+		size_t x1 = LSCr_below(&rng, buffer.width);
+		size_t x2 = LSCr_below(&rng, buffer.width);
+		size_t y1 = LSCr_below(&rng, buffer.height);
+		size_t y2 = LSCr_below(&rng, buffer.height);
+		double z1 = -buffer.screen - (double) LSCr_below(&rng, depth);
+		double z2 = -buffer.screen - (double) LSCr_below(&rng, depth);
 		
 		if(colour && len_fgs) LSCl_setfgz(&buffer, x1, y1, z1,
-			x2, y2, z2, fgs[rand() % len_fgs]);
+			x2, y2, z2, fgs[LSCr_below(&rng, len_fgs)]);
 
 		if(colour && len_bgs) LSCl_setbgz(&buffer, x1, y1, z1,
-			x2, y2, z2, bgs[rand() % len_bgs]);
+			x2, y2, z2, bgs[LSCr_below(&rng, len_bgs)]);
 
 		if(len_chrs) LSCl_setz(&buffer, x1, y1, z1,
-			x2, y2, z2, chrs[rand() % len_chrs]);
+			x2, y2, z2, chrs[LSCr_below(&rng, len_chrs)]);
 
 		else LSCl_drawz(&buffer, x1, y1, z1, x2, y2, z2);
 	}
 }
 
-int main(int argc, char **argv) {
-	name = argv[0];
-	init(argc, argv);
-
-	signal(SIGINT, on_interrupt);
-
+void init_tty() {
 	int ret = tcgetattr(STDIN_FILENO, &cooked);
 	if(ret == -1) {
 		puts("Error getting terminal properties with tcgetattr().");
@@ -136,39 +145,118 @@ int main(int argc, char **argv) {
 		exit(2);
 	}
 
-	printf("\033[999;999H\033[6n");
-	while(getchar() != '\033');
-
-	ret = scanf("[%zu;%zuR", &height, &width);
-	if(ret != 2) {
+	ret = LSC_winsize(STDOUT_FILENO, &width, &height);
+	if(ret != LSCE_OK) {
 		tcsetattr(STDIN_FILENO, TCSANOW, &cooked);
-		puts("Error getting screen size with ANSI escape codes.");
+		puts("Error getting screen size with TIOCGWINSZ.");
 		exit(3);
 	}
 
+	LSC_winch();
+
 	printf("\033[?25l");
+}
+
+void exit_tty() {
+	if(headless) return;
+
+	tcsetattr(STDIN_FILENO, TCSANOW, &cooked);
+	printf("\033[?25h");
+}
+
+void resize() {
+	if(headless || !LSC_resized()) return;
+
+	int ret = LSC_winsize(STDOUT_FILENO, &width, &height);
+	if(ret != LSCE_OK) return;
+
+	ret = LSCb_resize(&buffer, width, height);
+	if(ret != LSCE_OK) {
+		running = false;
+		return;
+	}
+
+	depth = width > height? width: height;
+	printf("\033[2J");
+}
+
+uint64_t now() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+void present() {
+	if(!headless) {
+		LSCb_print(&buffer, 1);
+		mkdelay();
+		return;
+	}
+
+	LSCb_write(&buffer, quiet? -1: STDOUT_FILENO, 1);
+}
+
+void record(uint64_t ns) {
+	frame++;
+	total_ns += ns;
+
+	if(ns < min_ns) min_ns = ns;
+	if(ns > max_ns) max_ns = ns;
+}
+
+void report() {
+	if(!frame) return;
+
+	double secs = total_ns / 1e9;
+	double cells = (double) buffer.width * buffer.height * frame;
+	double bytes = (double) buffer.chwidth * buffer.width
+		* buffer.height * frame;
+
+	fprintf(stderr, "%zu frames of %zux%zu in %.3f s\n", frame,
+		buffer.width, buffer.height, secs);
+
+	fprintf(stderr, "frame time: %.3f ms avg, %.3f ms min, %.3f ms max\n",
+		total_ns / 1e6 / frame, min_ns / 1e6, max_ns / 1e6);
+
+	fprintf(stderr, "throughput: %.1f fps, %.0f cells/s, %.2f MB/s\n",
+		frame / secs, cells / secs, bytes / secs / 1e6);
+}
+
+int main(int argc, char **argv) {
+	name = argv[0];
+	init(argc, argv);
+
+	signal(SIGINT, on_interrupt);
+
+	if(!headless) init_tty();
 	LSCb_init(&buffer);
 
 	buffer.colour = colour;
 	buffer.height = height;
 	buffer.width = width;
 
-	ret = LSCb_alloc(&buffer);
+	int ret = LSCb_alloc(&buffer);
 	if(ret != LSCE_OK) {
-		tcsetattr(STDIN_FILENO, TCSANOW, &cooked);
+		exit_tty();
 		puts("Error initialising libScricon.");
-		printf("\033[?25h");
 		exit(4);
 	}
 
 	depth = width > height? width: height;
-	srand(time(NULL));
+	LSCr_seed(&rng, seed);
 
-	if(three_d) while(running) engine_3d();
-	else while(running) engine_2d();
+	while(running && (!frames || frame < frames)) {
+		resize();
+		uint64_t start = now();
 
-	tcsetattr(STDIN_FILENO, TCSANOW, &cooked);
-	printf("\033[?25h");
+		if(three_d) engine_3d();
+		else engine_2d();
+
+		record(now() - start);
+	}
+
+	exit_tty();
+	if(headless) report();
 	return 0;
 }
 
@@ -208,7 +296,12 @@ void help(int ret) {
 
 	puts("    -n, --count      set the number of line per frame");
 	puts("    -C, --colour     enable colour output");
-	puts("    -3, --3d         enable three dimensions\n");
+	puts("    -3, --3d         enable three dimensions");
+
+	puts("    -F, --frames N   stop after drawing N frames");
+	puts("    -G, --size WxH   render headless at the given size without a terminal");
+	puts("    -R, --seed S     set the random seed");
+	puts("    -q, --quiet      discard headless output instead of writing it\n");
 	
 	puts("  Note: CHRS is a single-string argument. FGS and BGS are a list of integers");
 	puts("        separated by spaces. FRAC and ROWS are doubles between 0.0 and 1.0.\n");
@@ -262,9 +355,36 @@ void init(int argc, char **argv) {
 	arg = LCa_new(); arg -> long_flag = "3d"; arg -> short_flag = '3';
 	arg -> var = var; arg -> value = true;
 
+	var = LCv_new(); var -> id = "frames";
+	var -> fmt = "%zu"; var -> data = &frames;
+	arg = LCa_new(); arg -> long_flag = "frames";
+	arg -> short_flag = 'F'; arg -> var = var;
+
+	var = LCv_new(); var -> id = "size";
+	var -> fmt = "%31c"; var -> data = size;
+	arg = LCa_new(); arg -> long_flag = "size";
+	arg -> short_flag = 'G'; arg -> var = var;
+
+	var = LCv_new(); var -> id = "seed";
+	var -> fmt = "%zu"; var -> data = &seed;
+	arg = LCa_new(); arg -> long_flag = "seed";
+	arg -> short_flag = 'R'; arg -> var = var;
+
+	var = LCv_new(); var -> id = "quiet"; var -> data = &quiet;
+	arg = LCa_new(); arg -> long_flag = "quiet"; arg -> short_flag = 'q';
+	arg -> var = var; arg -> value = true;
+
+	seed = time(NULL);
+
 	int ret = LCa_read(argc, argv);
 	if(ret != LCA_OK) help(1);
 
+	headless = strlen(size);
+	if(headless) {
+		ret = sscanf(size, "%zux%zu", &width, &height);
+		if(ret != 2 || !width || !height) help(1);
+	}
+
 	len_chrs = strlen(chrs);
 
 	if(!len_fgs) {
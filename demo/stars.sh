@@ -16,7 +16,7 @@
 # You should have received a copy of the GNU General Public License along with
 # this program. If not, see <https://www.gnu.org/licenses/>.
 
-chrs=".,+*\`'                                                               ";
+chrs=".,+*\`'";
 fgs="232 233 234 235 236 237 238 239 240 241 242 243 244 245 246 247 248 249 \
      250 251 252 253 254 255 16 52 88 124 160 196 202 208 214 220 226 227 228 \
      229 230 231 195 159 123 87 51 45 39 33 27 21 20 19 18 17 16"
@@ -73,8 +73,8 @@ case "$1" in
 		exit 1
 	fi
 
-	make rand_chars
-	./rand_chars -Cc "$chrs" -f $fgs -b 0 -d "$delay" -x 0.01
+	make particles
+	./particles -m stars -Cc "$chrs" -f $fgs -b 0 -d "$delay" -x 0.05
 ;;
 
 *)
@@ -91,7 +91,7 @@ case "$1" in
 		exit 1
 	fi
 
-	make rand_chars
-	./rand_chars -c "$chrs" -d "$delay" -x 0.01
+	make particles
+	./particles -m stars -c "$chrs" -d "$delay" -x 0.05
 ;;
 esac
\ No newline at end of file
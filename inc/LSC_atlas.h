@@ -0,0 +1,57 @@
+/* libScricon: The Simple Graphical Console Library
+ * Copyright (C) 2021-2022 Jyothiraditya Nellakra
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <LSC_buffer.h>
+
+#ifndef LSC_ATLAS_H
+#define LSC_ATLAS_H 1
+
+typedef struct {
+	bool colour;
+	size_t chwidth;
+
+	size_t count;
+	size_t slots;
+	LSCb_t *sprites;
+	size_t *offsets;
+
+	size_t used;
+	size_t size;
+	char *data;
+} LSCa_t;
+
+extern void LSCa_init(LSCa_t *atlas);
+extern void LSCa_free(LSCa_t *atlas);
+
+extern int LSCa_adds(LSCa_t *atlas, const char *str, size_t *id);
+
+extern int LSCa_addalls(LSCa_t *atlas, const char *str,
+	uint8_t fg, uint8_t bg, size_t *id);
+
+extern int LSCa_addb(LSCa_t *atlas, LSCb_t *buf, size_t x, size_t y,
+	size_t width, size_t height, size_t *id);
+
+extern void LSCa_stamp(LSCa_t *atlas, size_t id, LSCb_t *buf,
+	intmax_t x, intmax_t y);
+
+extern void LSCa_stampk(LSCa_t *atlas, size_t id, LSCb_t *buf,
+	intmax_t x, intmax_t y, const char *key);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,45 @@
+/* libScricon: The Simple Graphical Console Library
+ * Copyright (C) 2021-2022 Jyothiraditya Nellakra
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <LSC_buffer.h>
+
+#ifndef LSC_BRAILLE_H
+#define LSC_BRAILLE_H 1
+
+typedef struct {
+	size_t height;
+	size_t width;
+
+	LSCb_t dots;
+	LSCb_t frame;
+	uint64_t seen;
+} LSCd_t;
+
+extern const char *LSCd_blank;
+
+extern void LSCd_init(LSCd_t *canvas);
+extern int LSCd_alloc(LSCd_t *canvas);
+extern void LSCd_free(LSCd_t *canvas);
+
+extern void LSCd_set(LSCb_t *dots, size_t x, size_t y);
+extern void LSCd_unset(LSCb_t *dots, size_t x, size_t y);
+
+extern void LSCd_resolve(LSCd_t *canvas);
+
+#endif
@@ -17,12 +17,17 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include <stddef.h>
+#include <stdio.h>
+
+#include <LSC_glyphs.h>
 
 #ifndef LSC_BUFFER_H
 #define LSC_BUFFER_H 1
 
 typedef struct {
 	bool colour;
+	bool truecolour;
+	size_t glyph;
 	size_t chwidth;
 
 	size_t height;
@@ -32,25 +37,65 @@ typedef struct {
 	int validate;
 	const char *cchs;
 	char cch;
+	const LSCg_t *glyphs;
 
 	char *data;
 	double *zdata;
+
+	uint64_t *rows;
+	uint64_t epoch;
+	uint8_t *tiles;
+
+	uint32_t *wdata;
+	uint32_t *tdata;
+
+	void *(*alloc)(void *ctx, size_t size);
+	void (*free)(void *ctx, void *block, size_t size);
+	void *ctx;
+
+	void *block;
+	size_t capacity;
 } LSCb_t;
 
+typedef struct {
+	size_t x, y;
+	size_t width, height;
+} LSCb_rect_t;
+
 #define LSCB_VALIDATE_NONE 0
 #define LSCB_VALIDATE_CHAR 1
 #define LSCB_VALIDATE_SHAPE 2
 
+#define LSCB_ALIGN 64
+#define LSCB_HUGE (2 * 1024 * 1024)
+
+#define LSCB_TILE_W 8
+#define LSCB_TILE_H 4
+
 extern const char *LSCb_cch;
+extern const char *LSCb_rgbch;
 
 extern void LSCb_init(LSCb_t *buf);
 extern int LSCb_alloc(LSCb_t *buf);
+extern size_t LSCb_chwidth(const LSCb_t *buf);
+
+extern void *LSCb_malloc(void *ctx, size_t size);
+extern void LSCb_mfree(void *ctx, void *block, size_t size);
+
+extern void *LSCb_mmap(void *ctx, size_t size);
+extern void LSCb_munmap(void *ctx, void *block, size_t size);
 
 extern void LSCb_clear(LSCb_t *buf);
+extern void LSCb_touch(LSCb_t *buf, size_t y, size_t height);
+extern void LSCb_dirty(LSCb_t *buf, size_t x, size_t y,
+	size_t width, size_t height);
 extern void LSCb_free(LSCb_t *buf);
 
+extern int LSCb_resize(LSCb_t *buf, size_t width, size_t height);
+
 extern void LSCb_set(LSCb_t *buf, size_t x, size_t y, char chr);
 extern int LSCb_print(LSCb_t *buf, size_t y);
+extern int LSCb_write(LSCb_t *buf, int fd, size_t y);
 
 extern void LSCb_setcol(LSCb_t *buf, size_t x, size_t y,
 	uint8_t fg, uint8_t bg);
@@ -81,6 +126,48 @@ extern void LSCb_setbgz(LSCb_t *buf, size_t x, size_t y, double z, uint8_t bg);
 extern void LSCb_setallz(LSCb_t *buf, size_t x, size_t y, double z,
 	char chr, uint8_t fg, uint8_t bg);
 
+extern void LSCb_setrgb(LSCb_t *buf, size_t x, size_t y,
+	uint32_t fg, uint32_t bg);
+
+extern void LSCb_setfgrgb(LSCb_t *buf, size_t x, size_t y, uint32_t fg);
+extern void LSCb_setbgrgb(LSCb_t *buf, size_t x, size_t y, uint32_t bg);
+
+extern void LSCb_setallrgb(LSCb_t *buf, size_t x, size_t y,
+	char chr, uint32_t fg, uint32_t bg);
+
+extern void LSCb_setrgbz(LSCb_t *buf, size_t x, size_t y, double z,
+	uint32_t fg, uint32_t bg);
+
+extern void LSCb_setfgrgbz(LSCb_t *buf, size_t x, size_t y, double z,
+	uint32_t fg);
+
+extern void LSCb_setbgrgbz(LSCb_t *buf, size_t x, size_t y, double z,
+	uint32_t bg);
+
+extern void LSCb_setallrgbz(LSCb_t *buf, size_t x, size_t y, double z,
+	char chr, uint32_t fg, uint32_t bg);
+
+extern void LSCb_setrgbv(LSCb_t *buf, size_t x, size_t y,
+	uint32_t fg, uint32_t bg);
+
+extern void LSCb_setfgrgbv(LSCb_t *buf, size_t x, size_t y, uint32_t fg);
+extern void LSCb_setbgrgbv(LSCb_t *buf, size_t x, size_t y, uint32_t bg);
+
+extern void LSCb_setallrgbv(LSCb_t *buf, size_t x, size_t y,
+	char chr, uint32_t fg, uint32_t bg);
+
+extern void LSCb_setrgbzv(LSCb_t *buf, size_t x, size_t y, double z,
+	uint32_t fg, uint32_t bg);
+
+extern void LSCb_setfgrgbzv(LSCb_t *buf, size_t x, size_t y, double z,
+	uint32_t fg);
+
+extern void LSCb_setbgrgbzv(LSCb_t *buf, size_t x, size_t y, double z,
+	uint32_t bg);
+
+extern void LSCb_setallrgbzv(LSCb_t *buf, size_t x, size_t y, double z,
+	char chr, uint32_t fg, uint32_t bg);
+
 extern size_t LSCb_getxz(LSCb_t *buf, double x, double z);
 extern size_t LSCb_getyz(LSCb_t *buf, double y, double z);
 
@@ -142,4 +229,27 @@ extern void LSCb_setbgszv(LSCb_t *buf, size_t x, size_t y, double z,
 extern void LSCb_setallszv(LSCb_t *buf, size_t x, size_t y, double z,
 	const char *data);
 
+extern int LSCb_heaton(LSCb_t *buf);
+extern void LSCb_heatoff(LSCb_t *buf);
+extern void LSCb_heatclear(LSCb_t *buf);
+
+extern void LSCb_heatmap(LSCb_t *buf, bool tests);
+extern int LSCb_heatdump(LSCb_t *buf, FILE *file, bool tests);
+
+extern size_t LSCb_tiles(size_t width, size_t height);
+extern size_t LSCb_rects(LSCb_t *buf, LSCb_rect_t *rects, size_t count);
+extern void LSCb_clean(LSCb_t *buf);
+
+extern void LSCb_blit(LSCb_t *dst, intmax_t x, intmax_t y, LSCb_t *src,
+	size_t sx, size_t sy, size_t width, size_t height);
+
+extern void LSCb_blitz(LSCb_t *dst, intmax_t x, intmax_t y, LSCb_t *src,
+	size_t sx, size_t sy, size_t width, size_t height);
+
+extern void LSCb_blitk(LSCb_t *dst, intmax_t x, intmax_t y, LSCb_t *src,
+	size_t sx, size_t sy, size_t width, size_t height, const char *key);
+
+extern void LSCb_blitkz(LSCb_t *dst, intmax_t x, intmax_t y, LSCb_t *src,
+	size_t sx, size_t sy, size_t width, size_t height, const char *key);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,66 @@
+/* libScricon: The Simple Graphical Console Library
+ * Copyright (C) 2021-2022 Jyothiraditya Nellakra
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#include <stdint.h>
+#include <string.h>
+
+#ifndef LSC_COLOUR_H
+#define LSC_COLOUR_H 1
+
+extern const char LSCc_codes[256][4];
+
+#define LSCC_RGB(r, g, b) \
+	((uint32_t) (r) << 16 | (uint32_t) (g) << 8 | (uint32_t) (b))
+
+static inline void LSCc_bg(char *data, uint8_t bg) {
+	memcpy(data, "\033[48;5;", 7);
+	memcpy(data + 7, LSCc_codes[bg], 3);
+	data[10] = 'm';
+}
+
+static inline void LSCc_fg(char *data, uint8_t fg) {
+	memcpy(data, "\033[38;5;", 7);
+	memcpy(data + 7, LSCc_codes[fg], 3);
+	data[10] = 'm';
+}
+
+static inline void LSCc_col(char *data, uint8_t fg, uint8_t bg) {
+	LSCc_bg(data, bg);
+	LSCc_fg(data + 11, fg);
+}
+
+static inline void LSCc_rgbbg(char *data, uint32_t bg) {
+	memcpy(data, "\033[48;2;", 7);
+	memcpy(data + 7, LSCc_codes[bg >> 16 & 0xff], 3); data[10] = ';';
+	memcpy(data + 11, LSCc_codes[bg >> 8 & 0xff], 3); data[14] = ';';
+	memcpy(data + 15, LSCc_codes[bg & 0xff], 3);
+	data[18] = 'm';
+}
+
+static inline void LSCc_rgbfg(char *data, uint32_t fg) {
+	memcpy(data, "\033[38;2;", 7);
+	memcpy(data + 7, LSCc_codes[fg >> 16 & 0xff], 3); data[10] = ';';
+	memcpy(data + 11, LSCc_codes[fg >> 8 & 0xff], 3); data[14] = ';';
+	memcpy(data + 15, LSCc_codes[fg & 0xff], 3);
+	data[18] = 'm';
+}
+
+static inline void LSCc_rgb(char *data, uint32_t fg, uint32_t bg) {
+	LSCc_rgbbg(data, bg);
+	LSCc_rgbfg(data + 19, fg);
+}
+
+#endif
\ No newline at end of file
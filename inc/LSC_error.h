@@ -33,6 +33,13 @@
 #define LSC_THREAD_CREATE_ERR 5
 #define LSC_THREAD_JOIN_ERR 6
 #define LSC_PRINTF_ERR 7
+#define LSC_WRITE_ERR 8
+#define LSC_IOCTL_ERR 9
+#define LSC_SHM_ERR 10
+#define LSC_FCNTL_ERR 11
+#define LSC_READ_ERR 12
+#define LSC_FORMAT_ERR 13
+#define LSC_GLYPH_ERR 14
 
 extern bool LSCe_auto;
 extern thread_local int LSC_errno;
@@ -0,0 +1,66 @@
+/* libScricon: The Simple Graphical Console Library
+ * Copyright (C) 2021-2022 Jyothiraditya Nellakra
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <threads.h>
+
+#include <LSC_buffer.h>
+#include <LSC_output.h>
+
+#ifndef LSC_FANOUT_H
+#define LSC_FANOUT_H 1
+
+typedef struct {
+	LSCo_t out;
+	thrd_t thread;
+	void *fan;
+
+	uint64_t seen;
+	bool stop;
+	bool failed;
+} LSCf_view_t;
+
+typedef struct {
+	mtx_t lock;
+	cnd_t cond;
+
+	LSCb_t frame;
+	uint64_t generation;
+	bool sync;
+
+	LSCb_t *source;
+	uint64_t seen;
+
+	size_t cached;
+	LSCo_row_t *cache;
+
+	size_t count;
+	size_t slots;
+	LSCf_view_t **views;
+} LSCf_t;
+
+extern int LSCf_init(LSCf_t *fan);
+extern void LSCf_free(LSCf_t *fan);
+
+extern int LSCf_add(LSCf_t *fan, int fd);
+extern int LSCf_remove(LSCf_t *fan, int fd);
+extern int LSCf_reap(LSCf_t *fan);
+
+extern int LSCf_publish(LSCf_t *fan, LSCb_t *buf);
+
+#endif
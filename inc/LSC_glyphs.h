@@ -0,0 +1,56 @@
+/* libScricon: The Simple Graphical Console Library
+ * Copyright (C) 2021-2022 Jyothiraditya Nellakra
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifndef LSC_GLYPHS_H
+#define LSC_GLYPHS_H 1
+
+typedef struct {
+	uint8_t len[256];
+	bool wide[256];
+	char utf8[256][4];
+} LSCg_t;
+
+#define LSCG_H 0x80
+#define LSCG_V 0x81
+#define LSCG_TL 0x82
+#define LSCG_TR 0x83
+#define LSCG_BL 0x84
+#define LSCG_BR 0x85
+#define LSCG_LTEE 0x86
+#define LSCG_RTEE 0x87
+#define LSCG_TTEE 0x88
+#define LSCG_BTEE 0x89
+#define LSCG_CROSS 0x8a
+
+#define LSCG_DOUBLE 0x10
+#define LSCG_HEAVY 0x20
+
+#define LSCG_LIGHT 0xb0
+#define LSCG_MEDIUM 0xb1
+#define LSCG_DARK 0xb2
+#define LSCG_FULL 0xb3
+#define LSCG_UPPER 0xb4
+#define LSCG_LOWER 0xb5
+#define LSCG_LEFT 0xb6
+#define LSCG_RIGHT 0xb7
+
+extern void LSCg_init(LSCg_t *table);
+extern int LSCg_set(LSCg_t *table, uint8_t id, const char *utf8);
+
+#endif
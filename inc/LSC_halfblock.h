@@ -0,0 +1,44 @@
+/* libScricon: The Simple Graphical Console Library
+ * Copyright (C) 2021-2022 Jyothiraditya Nellakra
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <LSC_buffer.h>
+
+#ifndef LSC_HALFBLOCK_H
+#define LSC_HALFBLOCK_H 1
+
+typedef struct {
+	bool quad;
+	size_t height;
+	size_t width;
+
+	LSCb_t grid;
+	LSCb_t frame;
+	uint64_t seen;
+} LSCh_t;
+
+extern const char *LSCh_blank;
+
+extern void LSCh_init(LSCh_t *canvas);
+extern int LSCh_alloc(LSCh_t *canvas);
+extern void LSCh_free(LSCh_t *canvas);
+
+extern void LSCh_resolve(LSCh_t *canvas);
+
+#endif
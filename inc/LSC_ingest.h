@@ -0,0 +1,103 @@
+/* libScricon: The Simple Graphical Console Library
+ * Copyright (C) 2021-2022 Jyothiraditya Nellakra
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <threads.h>
+
+#include <LSC_buffer.h>
+
+#ifndef LSC_INGEST_H
+#define LSC_INGEST_H 1
+
+#define LSCI_PPM 0
+#define LSCI_Y4M 1
+#define LSCI_RGB 2
+#define LSCI_GREY 3
+
+#define LSCI_DEPTH 3
+
+typedef struct {
+	size_t width;
+	size_t height;
+	size_t channels;
+
+	size_t size;
+	uint8_t *data;
+} LSCi_frame_t;
+
+typedef struct {
+	int fd;
+	int format;
+	bool eof;
+
+	size_t width;
+	size_t height;
+	int chroma;
+
+	const char *ramp;
+	bool fill;
+	bool dither;
+
+	size_t head;
+	size_t tail;
+	uint8_t buffer[4096];
+
+	size_t size;
+	uint32_t *sums;
+	uint8_t *row;
+} LSCi_t;
+
+typedef struct {
+	LSCi_frame_t frame;
+	LSCb_t buf;
+} LSCi_job_t;
+
+typedef struct {
+	LSCi_t *in;
+
+	mtx_t lock;
+	cnd_t cond;
+	thrd_t reader;
+	thrd_t mapper;
+
+	size_t read;
+	size_t mapped;
+	size_t shown;
+
+	bool ended;
+	bool stop;
+	int error;
+
+	LSCi_job_t jobs[LSCI_DEPTH];
+} LSCi_stream_t;
+
+extern void LSCi_init(LSCi_t *in, int fd, int format);
+extern void LSCi_free(LSCi_t *in);
+
+extern void LSCi_frameinit(LSCi_frame_t *frame);
+extern void LSCi_framefree(LSCi_frame_t *frame);
+
+extern int LSCi_read(LSCi_t *in, LSCi_frame_t *frame);
+extern int LSCi_draw(LSCi_t *in, const LSCi_frame_t *frame, LSCb_t *buf);
+
+extern int LSCi_start(LSCi_stream_t *stream, LSCi_t *in, const LSCb_t *shape);
+extern LSCb_t *LSCi_next(LSCi_stream_t *stream);
+extern void LSCi_done(LSCi_stream_t *stream);
+extern void LSCi_stop(LSCi_stream_t *stream);
+
+#endif
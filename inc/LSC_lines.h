@@ -75,4 +75,6 @@ extern void LSCl_drawfgz(LSCb_t *buf, size_t x1, size_t y1, double z1,
 extern void LSCl_drawbgz(LSCb_t *buf, size_t x1, size_t y1, double z1,
 	size_t x2, size_t y2, double z2, uint8_t bg);
 
+extern void LSCl_dots(LSCb_t *dots, size_t x1, size_t y1, size_t x2, size_t y2);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,90 @@
+/* libScricon: The Simple Graphical Console Library
+ * Copyright (C) 2021-2022 Jyothiraditya Nellakra
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <poll.h>
+
+#include <LSC_buffer.h>
+
+#ifndef LSC_OUTPUT_H
+#define LSC_OUTPUT_H 1
+
+typedef struct {
+	bool valid;
+	size_t y;
+	size_t width;
+
+	uint64_t from;
+	uint64_t to;
+
+	size_t len;
+	size_t size;
+	char *data;
+} LSCo_row_t;
+
+typedef struct {
+	int fd;
+	size_t y;
+	bool sync;
+
+	bool valid;
+	bool colour;
+	size_t chwidth;
+	size_t height;
+	size_t width;
+	char *shadow;
+	uint64_t *hashes;
+
+	size_t escape;
+	const LSCg_t *glyphs;
+	bool styled;
+	char style[64];
+
+	LSCb_t *source;
+	uint64_t seen;
+
+	size_t cached;
+	LSCo_row_t *cache;
+
+	size_t sent;
+	size_t used;
+	size_t size;
+	char *data;
+
+	LSCb_t *pending;
+} LSCo_t;
+
+extern void LSCo_init(LSCo_t *out, int fd);
+extern void LSCo_free(LSCo_t *out);
+extern void LSCo_reset(LSCo_t *out);
+
+extern uint64_t LSCo_hash(const char *data, size_t len);
+extern void LSCo_uncache(LSCo_row_t *cache, size_t count);
+
+extern int LSCo_encode(LSCo_t *out, LSCb_t *buf);
+extern int LSCo_flush(LSCo_t *out);
+extern int LSCo_present(LSCo_t *out, LSCb_t *buf);
+
+extern int LSCo_nonblock(LSCo_t *out, bool nonblock);
+extern int LSCo_resume(LSCo_t *out);
+
+extern bool LSCo_busy(LSCo_t *out);
+extern void LSCo_pollfd(LSCo_t *out, struct pollfd *pfd);
+
+#endif
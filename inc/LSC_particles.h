@@ -0,0 +1,54 @@
+/* libScricon: The Simple Graphical Console Library
+ * Copyright (C) 2021-2022 Jyothiraditya Nellakra
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <LSC_buffer.h>
+
+#ifndef LSC_PARTICLES_H
+#define LSC_PARTICLES_H 1
+
+typedef struct {
+	size_t count;
+	size_t capacity;
+
+	float *x, *y, *z;
+	float *dx, *dy;
+	float *life;
+
+	char *chr;
+	uint8_t *fg;
+
+	void *block;
+} LSCp_t;
+
+extern void LSCp_init(LSCp_t *ps);
+extern int LSCp_alloc(LSCp_t *ps);
+extern void LSCp_free(LSCp_t *ps);
+
+extern size_t LSCp_spawn(LSCp_t *ps, size_t count);
+extern void LSCp_kill(LSCp_t *ps, size_t i);
+extern size_t LSCp_reap(LSCp_t *ps);
+
+extern void LSCp_update(LSCp_t *ps, float dt, float ax, float ay);
+extern void LSCp_clip(LSCp_t *ps, float width, float height);
+extern void LSCp_wrap(LSCp_t *ps, float width, float height);
+
+extern void LSCp_splat(LSCp_t *ps, LSCb_t *buf);
+extern void LSCp_splatz(LSCp_t *ps, LSCb_t *buf);
+
+#endif
@@ -0,0 +1,51 @@
+/* libScricon: The Simple Graphical Console Library
+ * Copyright (C) 2021-2022 Jyothiraditya Nellakra
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <LSC_buffer.h>
+
+#ifndef LSC_QUANTIZE_H
+#define LSC_QUANTIZE_H 1
+
+extern uint32_t LSCq_palette[256];
+extern uint8_t LSCq_lut[32][32][32];
+
+extern void LSCq_init(void);
+
+static inline uint8_t LSCq_index(uint8_t r, uint8_t g, uint8_t b) {
+	return LSCq_lut[r >> 3][g >> 3][b >> 3];
+}
+
+static inline uint8_t LSCq_packed(uint32_t rgb) {
+	return LSCq_lut[rgb >> 19 & 31][rgb >> 11 & 31][rgb >> 3 & 31];
+}
+
+extern void LSCq_row(uint8_t *dst, const uint8_t *rgb, size_t count);
+extern void LSCq_rowp(uint8_t *dst, const uint32_t *rgb, size_t count);
+
+extern void LSCq_dither(uint8_t *dst, const uint8_t *rgb, size_t count,
+	size_t x, size_t y);
+
+extern void LSCq_fgrow(LSCb_t *buf, size_t x, size_t y, const uint8_t *rgb,
+	size_t count, bool dither);
+
+extern void LSCq_bgrow(LSCb_t *buf, size_t x, size_t y, const uint8_t *rgb,
+	size_t count, bool dither);
+
+#endif
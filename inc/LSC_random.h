@@ -0,0 +1,89 @@
+/* libScricon: The Simple Graphical Console Library
+ * Copyright (C) 2021-2022 Jyothiraditya Nellakra
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <threads.h>
+
+#include <LSC_buffer.h>
+
+#ifndef LSC_RANDOM_H
+#define LSC_RANDOM_H 1
+
+typedef struct {
+	uint64_t s[4];
+} LSCr_t;
+
+typedef struct {
+	const char *chrs;
+	size_t len_chrs;
+
+	const uint8_t *fgs;
+	size_t len_fgs;
+
+	const uint8_t *bgs;
+	size_t len_bgs;
+} LSCr_pick_t;
+
+extern thread_local LSCr_t LSCr_local;
+
+extern void LSCr_seed(LSCr_t *rng, uint64_t seed);
+extern LSCr_t *LSCr_thread(void);
+
+static inline uint64_t LSCr_rotl(uint64_t n, int bits) {
+	return (n << bits) | (n >> (64 - bits));
+}
+
+static inline uint64_t LSCr_next(LSCr_t *rng) {
+	uint64_t *s = rng -> s;
+	const uint64_t result = LSCr_rotl(s[1] * 5, 7) * 9;
+	const uint64_t t = s[1] << 17;
+
+	s[2] ^= s[0]; s[3] ^= s[1];
+	s[1] ^= s[2]; s[0] ^= s[3];
+
+	s[2] ^= t;
+	s[3] = LSCr_rotl(s[3], 45);
+	return result;
+}
+
+/* The top 32 bits scaled to [0, n), with the few values that would make some
+ * results more likely than others thrown away and drawn again. */
+
+static inline uint32_t LSCr_below(LSCr_t *rng, uint32_t n) {
+	uint64_t m = (LSCr_next(rng) >> 32) * n;
+
+	if((uint32_t) m < n) {
+		const uint32_t t = -n % n;
+		while((uint32_t) m < t) m = (LSCr_next(rng) >> 32) * n;
+	}
+
+	return m >> 32;
+}
+
+static inline float LSCr_float(LSCr_t *rng) {
+	return (LSCr_next(rng) >> 40) * 0x1.0p-24f;
+}
+
+extern void LSCr_bytes(LSCr_t *rng, void *dst, size_t size);
+
+extern void LSCr_fill(LSCr_t *rng, LSCb_t *buf, size_t y, size_t height,
+	const LSCr_pick_t *pick);
+
+extern void LSCr_scatter(LSCr_t *rng, LSCb_t *buf, size_t count,
+	const LSCr_pick_t *pick);
+
+#endif
@@ -0,0 +1,48 @@
+/* libScricon: The Simple Graphical Console Library
+ * Copyright (C) 2021-2022 Jyothiraditya Nellakra
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <LSC_buffer.h>
+
+#ifndef LSC_SHM_H
+#define LSC_SHM_H 1
+
+typedef struct {
+	LSCb_t buf;
+
+	int fd;
+	const char *name;
+	bool owner;
+
+	void *map;
+	size_t size;
+	size_t stride;
+	unsigned slot;
+} LSCm_t;
+
+extern void LSCm_init(LSCm_t *shm);
+extern void LSCm_free(LSCm_t *shm);
+
+extern int LSCm_create(LSCm_t *shm, const char *name);
+extern int LSCm_open(LSCm_t *shm, const char *name);
+extern int LSCm_attach(LSCm_t *shm, int fd);
+
+extern void LSCm_publish(LSCm_t *shm);
+extern bool LSCm_acquire(LSCm_t *shm);
+
+#endif
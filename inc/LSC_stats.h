@@ -0,0 +1,68 @@
+/* libScricon: The Simple Graphical Console Library
+ * Copyright (C) 2021-2022 Jyothiraditya Nellakra
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <threads.h>
+
+#ifndef LSC_STATS_H
+#define LSC_STATS_H 1
+
+typedef struct {
+	uint64_t primitives;
+	uint64_t clipped;
+
+	uint64_t tested;
+	uint64_t depth_tested;
+	uint64_t written;
+	uint64_t rejected;
+
+	uint64_t clears;
+	uint64_t scrolls;
+	uint64_t frames;
+	uint64_t dropped;
+
+	uint64_t encoded;
+	uint64_t sent;
+
+	uint64_t encode_ns;
+	uint64_t write_ns;
+} LSCs_t;
+
+extern const bool LSCs_enabled;
+extern thread_local LSCs_t LSCs_local;
+
+extern uint64_t LSCs_now();
+
+extern void LSCs_snap(LSCs_t *stats, bool reset);
+extern void LSCs_add(LSCs_t *total, const LSCs_t *stats);
+
+#ifdef LSC_STATS
+#define LSCS_ADD(field, n) (LSCs_local.field += (n))
+#define LSCS_START(var) uint64_t var = LSCs_now()
+#define LSCS_STOP(field, var) (LSCs_local.field += LSCs_now() - (var))
+
+#define LSCS_TEST(cond) (LSCs_local.depth_tested++, (cond)? \
+	(LSCs_local.rejected++, true): false)
+
+#else
+#define LSCS_ADD(field, n) ((void) 0)
+#define LSCS_START(var) ((void) 0)
+#define LSCS_STOP(field, var) ((void) 0)
+#define LSCS_TEST(cond) (cond)
+
+#endif
+#endif
\ No newline at end of file
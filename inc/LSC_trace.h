@@ -0,0 +1,39 @@
+/* libScricon: The Simple Graphical Console Library
+ * Copyright (C) 2021-2022 Jyothiraditya Nellakra
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#include <stddef.h>
+#include <stdio.h>
+
+#ifndef LSC_TRACE_H
+#define LSC_TRACE_H 1
+
+extern size_t LSCx_size;
+
+extern void LSCx_begin(const char *name);
+extern void LSCx_end(const char *name);
+
+extern int LSCx_dump(FILE *file);
+
+#ifdef LSC_TRACE
+#define LSCX_BEGIN(name) LSCx_begin(name)
+#define LSCX_END(name) LSCx_end(name)
+
+#else
+#define LSCX_BEGIN(name) ((void) 0)
+#define LSCX_END(name) ((void) 0)
+
+#endif
+#endif
\ No newline at end of file
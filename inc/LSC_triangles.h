@@ -57,4 +57,7 @@ extern void LSCt_setallz(LSCb_t *buf, size_t x1, size_t y1, double z1,
 	size_t x2, size_t y2, double z2,
 	size_t x3, size_t y3, double z3, char chr, uint8_t fg, uint8_t bg);
 
+extern void LSCt_dots(LSCb_t *dots, size_t x1, size_t y1, size_t x2, size_t y2,
+	size_t x3, size_t y3);
+
 #endif
\ No newline at end of file
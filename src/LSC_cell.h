@@ -0,0 +1,50 @@
+/* libScricon: The Simple Graphical Console Library
+ * Copyright (C) 2021-2022 Jyothiraditya Nellakra
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <LSC_buffer.h>
+#include <LSC_stats.h>
+
+#ifndef LSC_CELL_H
+#define LSC_CELL_H 1
+
+/* Helpers shared by the parts of the library that write cells themselves,
+ * kept out of inc/ since they aren't part of the API. LSCb_mark() counts a
+ * write and stamps the cell's row and tile as dirty, and LSCb_occluded()
+ * runs the depth test for cell i, counting it for the stats and heatmap. */
+
+static inline void LSCb_mark(LSCb_t *buf, size_t x, size_t y) {
+	LSCS_ADD(written, 1);
+	if(buf -> rows) {
+		const size_t cols = (buf -> width + LSCB_TILE_W - 1)
+			/ LSCB_TILE_W;
+
+		buf -> rows[y] = buf -> epoch;
+		buf -> tiles[x / LSCB_TILE_W + y / LSCB_TILE_H * cols] = 1;
+	}
+
+	if(buf -> wdata) buf -> wdata[x + y * buf -> width]++;
+}
+
+static inline bool LSCb_occluded(LSCb_t *buf, size_t i, double z) {
+	if(buf -> tdata) buf -> tdata[i]++;
+	return LSCS_TEST(buf -> zdata[i] > z);
+}
+
+#endif
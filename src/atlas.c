@@ -0,0 +1,194 @@
+/* libScricon: The Simple Graphical Console Library
+ * Copyright (C) 2021-2022 Jyothiraditya Nellakra
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <LSC_atlas.h>
+#include <LSC_buffer.h>
+#include <LSC_colour.h>
+#include <LSC_error.h>
+
+void LSCa_init(LSCa_t *atlas) {
+	atlas -> colour = false;
+	atlas -> chwidth = 1;
+
+	atlas -> count = 0;
+	atlas -> slots = 0;
+	atlas -> sprites = NULL;
+	atlas -> offsets = NULL;
+
+	atlas -> used = 0;
+	atlas -> size = 0;
+	atlas -> data = NULL;
+}
+
+void LSCa_free(LSCa_t *atlas) {
+	free(atlas -> sprites);
+	atlas -> sprites = NULL;
+
+	free(atlas -> offsets);
+	atlas -> offsets = NULL;
+
+	free(atlas -> data);
+	atlas -> data = NULL;
+
+	atlas -> count = atlas -> slots = 0;
+	atlas -> used = atlas -> size = 0;
+}
+
+static int reserve(LSCa_t *atlas, size_t bytes) {
+	if(atlas -> count == atlas -> slots) {
+		size_t slots = atlas -> slots? atlas -> slots * 2: 16;
+
+		LSCb_t *sprites = realloc(atlas -> sprites,
+			slots * sizeof(LSCb_t));
+
+		if(!sprites) goto error;
+		atlas -> sprites = sprites;
+
+		size_t *offsets = realloc(atlas -> offsets,
+			slots * sizeof(size_t));
+
+		if(!offsets) goto error;
+		atlas -> offsets = offsets;
+		atlas -> slots = slots;
+	}
+
+	if(atlas -> used + bytes > atlas -> size) {
+		size_t size = atlas -> size? atlas -> size * 2: 4096;
+		while(size < atlas -> used + bytes) size *= 2;
+
+		char *data = realloc(atlas -> data, size);
+		if(!data) goto error;
+
+		atlas -> data = data;
+		atlas -> size = size;
+
+		for(size_t i = 0; i < atlas -> count; i++)
+			atlas -> sprites[i].data = data + atlas -> offsets[i];
+	}
+
+	return LSCE_OK;
+
+error:
+	if(LSCe_auto) perror("stdlib");
+	LSC_errno = LSC_MALLOC_ERR;
+	return LSCE_NOOP;
+}
+
+static LSCb_t *push(LSCa_t *atlas, size_t width, size_t height, size_t *id) {
+	atlas -> chwidth = atlas -> colour? strlen(LSCb_cch): 1;
+
+	int ret = reserve(atlas, atlas -> chwidth * width * height);
+	if(ret != LSCE_OK) return NULL;
+
+	LSCb_t *sprite = &atlas -> sprites[atlas -> count];
+	LSCb_init(sprite);
+
+	sprite -> colour = atlas -> colour;
+	sprite -> chwidth = atlas -> chwidth;
+	sprite -> width = width;
+	sprite -> height = height;
+	sprite -> data = atlas -> data + atlas -> used;
+
+	atlas -> offsets[atlas -> count] = atlas -> used;
+	atlas -> used += atlas -> chwidth * width * height;
+
+	if(id) *id = atlas -> count;
+	atlas -> count++;
+	return sprite;
+}
+
+static int add(LSCa_t *atlas, const char *str, const char *prefix,
+	size_t *id)
+{
+	size_t width = 0, height = 1;
+
+	for(size_t i = 0, len = 0; str[i]; i++) {
+		if(str[i] == '\n') { len = 0; height++; continue; }
+		if(++len > width) width = len;
+	}
+
+	LSCb_t *sprite = push(atlas, width, height, id);
+	if(!sprite) return LSCE_NOOP;
+
+	const size_t chwidth = sprite -> chwidth;
+	for(size_t i = 0; i < width * height; i++) {
+		if(chwidth > 1) memcpy(sprite -> data + i * chwidth,
+			prefix, chwidth - 1);
+
+		sprite -> data[(i + 1) * chwidth - 1] = ' ';
+	}
+
+	for(size_t i = 0, x = 0, y = 0; str[i]; i++) {
+		if(str[i] == '\n') { x = 0; y++; continue; }
+		sprite -> data[(x++ + y * width + 1) * chwidth - 1] = str[i];
+	}
+
+	return LSCE_OK;
+}
+
+int LSCa_adds(LSCa_t *atlas, const char *str, size_t *id) {
+	return add(atlas, str, LSCb_cch, id);
+}
+
+int LSCa_addalls(LSCa_t *atlas, const char *str,
+	uint8_t fg, uint8_t bg, size_t *id)
+{
+	char prefix[22];
+	LSCc_col(prefix, fg, bg);
+	return add(atlas, str, prefix, id);
+}
+
+int LSCa_addb(LSCa_t *atlas, LSCb_t *buf, size_t x, size_t y,
+	size_t width, size_t height, size_t *id)
+{
+	if(x >= buf -> width || y >= buf -> height) width = height = 0;
+	if(width > buf -> width - x) width = buf -> width - x;
+	if(height > buf -> height - y) height = buf -> height - y;
+
+	LSCb_t *sprite = push(atlas, width, height, id);
+	if(!sprite) return LSCE_NOOP;
+
+	if(sprite -> colour && !buf -> colour)
+		for(size_t i = 0; i < width * height; i++)
+			memcpy(sprite -> data + i * sprite -> chwidth,
+				LSCb_cch, sprite -> chwidth);
+
+	LSCb_blit(sprite, 0, 0, buf, x, y, width, height);
+	return LSCE_OK;
+}
+
+void LSCa_stamp(LSCa_t *atlas, size_t id, LSCb_t *buf,
+	intmax_t x, intmax_t y)
+{
+	LSCb_t *sprite = &atlas -> sprites[id];
+	LSCb_blit(buf, x, y, sprite, 0, 0, sprite -> width, sprite -> height);
+}
+
+void LSCa_stampk(LSCa_t *atlas, size_t id, LSCb_t *buf,
+	intmax_t x, intmax_t y, const char *key)
+{
+	LSCb_t *sprite = &atlas -> sprites[id];
+
+	LSCb_blitk(buf, x, y, sprite, 0, 0, sprite -> width,
+		sprite -> height, key);
+}
\ No newline at end of file
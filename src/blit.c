@@ -0,0 +1,166 @@
+/* libScricon: The Simple Graphical Console Library
+ * Copyright (C) 2021-2022 Jyothiraditya Nellakra
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <LSC_buffer.h>
+#include <LSC_stats.h>
+#include <LSC_trace.h>
+
+typedef struct {
+	size_t dx, dy;
+	size_t sx, sy;
+	size_t width, height;
+
+} rect_t;
+
+static bool clip(LSCb_t *dst, intmax_t x, intmax_t y, LSCb_t *src,
+	size_t sx, size_t sy, size_t width, size_t height, rect_t *rect)
+{
+	if(sx >= src -> width || sy >= src -> height) return false;
+	if(width > src -> width - sx) width = src -> width - sx;
+	if(height > src -> height - sy) height = src -> height - sy;
+
+	if(x < 0) {
+		if((uintmax_t) -x >= width) return false;
+		sx += -x; width -= -x; x = 0;
+	}
+
+	if(y < 0) {
+		if((uintmax_t) -y >= height) return false;
+		sy += -y; height -= -y; y = 0;
+	}
+
+	if((uintmax_t) x >= dst -> width || (uintmax_t) y >= dst -> height)
+		return false;
+
+	if(width > dst -> width - x) width = dst -> width - x;
+	if(height > dst -> height - y) height = dst -> height - y;
+
+	rect -> dx = x; rect -> dy = y;
+	rect -> sx = sx; rect -> sy = sy;
+	rect -> width = width; rect -> height = height;
+
+	return width && height;
+}
+
+static void copy(LSCb_t *dst, size_t di, LSCb_t *src, size_t si, size_t len) {
+	const size_t dw = dst -> chwidth, sw = src -> chwidth;
+	char *restrict to = dst -> data + di * dw;
+	const char *from = src -> data + si * sw;
+
+	if(dw == sw) {
+		memmove(to, from, len * dw);
+		return;
+	}
+
+	if(dw == 1) {
+		for(size_t i = 0; i < len; i++) to[i] = from[i * sw + sw - 1];
+		return;
+	}
+
+	if(sw == 1) {
+		for(size_t i = 0; i < len; i++) to[i * dw + dw - 1] = from[i];
+		return;
+	}
+
+	for(size_t i = 0; i < len; i++)
+		to[i * dw + dw - 1] = from[i * sw + sw - 1];
+}
+
+static void blit(LSCb_t *dst, LSCb_t *src, rect_t rect,
+	const char *key, bool depth)
+{
+	bool back = dst == src && (rect.dy > rect.sy
+		|| (rect.dy == rect.sy && rect.dx > rect.sx));
+
+	LSCX_BEGIN("blit");
+	LSCS_ADD(primitives, 1);
+	if(!key && !depth) LSCS_ADD(written, rect.width * rect.height);
+
+	for(size_t k = 0; k < rect.height; k++) {
+		size_t i = back? rect.height - k - 1: k;
+		size_t di = rect.dx + (rect.dy + i) * dst -> width;
+		size_t si = rect.sx + (rect.sy + i) * src -> width;
+
+		if(!key && !depth) {
+			copy(dst, di, src, si, rect.width);
+
+			if(dst -> wdata) for(size_t j = 0; j < rect.width; j++)
+				dst -> wdata[di + j]++;
+
+			continue;
+		}
+
+		for(size_t l = 0; l < rect.width; l++) {
+			size_t j = back? rect.width - l - 1: l;
+
+			if(key && !memcmp(src -> data + (si + j) * src -> chwidth,
+				key, src -> chwidth)) { continue; }
+
+			if(depth) {
+				if(dst -> tdata) dst -> tdata[di + j]++;
+				if(LSCS_TEST(dst -> zdata[di + j]
+					> src -> zdata[si + j])) { continue; }
+
+				dst -> zdata[di + j] = src -> zdata[si + j];
+			}
+
+			copy(dst, di + j, src, si + j, 1);
+			LSCS_ADD(written, 1);
+
+			if(dst -> wdata) dst -> wdata[di + j]++;
+		}
+	}
+
+	LSCb_dirty(dst, rect.dx, rect.dy, rect.width, rect.height);
+	LSCX_END("blit");
+}
+
+void LSCb_blit(LSCb_t *dst, intmax_t x, intmax_t y, LSCb_t *src,
+	size_t sx, size_t sy, size_t width, size_t height)
+{
+	rect_t rect;
+	if(clip(dst, x, y, src, sx, sy, width, height, &rect))
+		blit(dst, src, rect, NULL, false);
+}
+
+void LSCb_blitz(LSCb_t *dst, intmax_t x, intmax_t y, LSCb_t *src,
+	size_t sx, size_t sy, size_t width, size_t height)
+{
+	rect_t rect;
+	if(clip(dst, x, y, src, sx, sy, width, height, &rect))
+		blit(dst, src, rect, NULL, true);
+}
+
+void LSCb_blitk(LSCb_t *dst, intmax_t x, intmax_t y, LSCb_t *src,
+	size_t sx, size_t sy, size_t width, size_t height, const char *key)
+{
+	rect_t rect;
+	if(clip(dst, x, y, src, sx, sy, width, height, &rect))
+		blit(dst, src, rect, key, false);
+}
+
+void LSCb_blitkz(LSCb_t *dst, intmax_t x, intmax_t y, LSCb_t *src,
+	size_t sx, size_t sy, size_t width, size_t height, const char *key)
+{
+	rect_t rect;
+	if(clip(dst, x, y, src, sx, sy, width, height, &rect))
+		blit(dst, src, rect, key, true);
+}
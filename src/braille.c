@@ -0,0 +1,122 @@
+/* libScricon: The Simple Graphical Console Library
+ * Copyright (C) 2021-2022 Jyothiraditya Nellakra
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <LSC_braille.h>
+#include <LSC_buffer.h>
+#include <LSC_error.h>
+#include <LSC_stats.h>
+#include <LSC_trace.h>
+
+#include "LSC_cell.h"
+
+const char *LSCd_blank = "⠀";
+
+/* Braille numbers its dots down the left column and then the right, with the
+ * bottom row added later as dots 7 and 8, so the bit for a dot depends on
+ * both of its coordinates within the cell. */
+
+static const uint8_t bits[4][2] = {
+	{0x01, 0x08}, {0x02, 0x10}, {0x04, 0x20}, {0x40, 0x80}
+};
+
+/* U+2800 plus the dot mask, encoded as UTF-8. The block starts on a 256 code
+ * point boundary, so every pattern is three bytes and the table can be built
+ * by the preprocessor. */
+
+#define CELL(m) {'\xe2', (char) (0xa0 | (m) >> 6), (char) (0x80 | ((m) & 0x3f))}
+#define CELL4(m) CELL(m), CELL(m + 1), CELL(m + 2), CELL(m + 3)
+#define CELL16(m) CELL4(m), CELL4(m + 4), CELL4(m + 8), CELL4(m + 12)
+#define CELL64(m) CELL16(m), CELL16(m + 16), CELL16(m + 32), CELL16(m + 48)
+
+static const char cells[256][3] = {
+	CELL64(0), CELL64(64), CELL64(128), CELL64(192)
+};
+
+void LSCd_init(LSCd_t *canvas) {
+	canvas -> height = 23;
+	canvas -> width = 80;
+
+	LSCb_init(&canvas -> dots);
+	canvas -> dots.cch = 0;
+
+	LSCb_init(&canvas -> frame);
+	canvas -> frame.glyph = 3;
+	canvas -> frame.cchs = LSCd_blank;
+
+	canvas -> seen = 0;
+}
+
+int LSCd_alloc(LSCd_t *canvas) {
+	canvas -> dots.width = canvas -> width;
+	canvas -> dots.height = canvas -> height;
+	if(LSCb_alloc(&canvas -> dots) != LSCE_OK) return LSCE_NOOP;
+
+	canvas -> frame.width = canvas -> width;
+	canvas -> frame.height = canvas -> height;
+	if(LSCb_alloc(&canvas -> frame) != LSCE_OK) {
+		LSCb_free(&canvas -> dots);
+		return LSCE_NOOP;
+	}
+
+	canvas -> seen = 0;
+	return LSCE_OK;
+}
+
+void LSCd_free(LSCd_t *canvas) {
+	LSCb_free(&canvas -> dots);
+	LSCb_free(&canvas -> frame);
+}
+
+void LSCd_set(LSCb_t *dots, size_t x, size_t y) {
+	const size_t cx = x / 2, cy = y / 4;
+
+	dots -> data[cx + cy * dots -> width] |= bits[y % 4][x % 2];
+	LSCb_mark(dots, cx, cy);
+}
+
+void LSCd_unset(LSCb_t *dots, size_t x, size_t y) {
+	const size_t cx = x / 2, cy = y / 4;
+
+	dots -> data[cx + cy * dots -> width] &= ~bits[y % 4][x % 2];
+	LSCb_mark(dots, cx, cy);
+}
+
+void LSCd_resolve(LSCd_t *canvas) {
+	LSCX_BEGIN("resolve");
+
+	LSCb_t *dots = &canvas -> dots, *frame = &canvas -> frame;
+
+	for(size_t y = 0; y < frame -> height; y++) {
+		if(dots -> rows[y] < canvas -> seen) continue;
+
+		const uint8_t *mask = (uint8_t *) dots -> data
+			+ y * dots -> width;
+
+		char *data = frame -> data + y * frame -> width * 3;
+
+		for(size_t x = 0; x < frame -> width; x++, data += 3)
+			memcpy(data, cells[mask[x]], 3);
+
+		LSCb_touch(frame, y, 1);
+	}
+
+	canvas -> seen = ++dots -> epoch;
+	LSCX_END("resolve");
+}
@@ -14,6 +14,7 @@
  * You should have received a copy of the GNU General Public License along with
  * this program. If not, see <https://www.gnu.org/licenses/>. */
 
+#include <errno.h>
 #include <float.h>
 #include <inttypes.h>
 #include <stdbool.h>
@@ -22,13 +23,25 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <sys/uio.h>
+#include <unistd.h>
+
 #include <LSC_buffer.h>
+#include <LSC_colour.h>
 #include <LSC_error.h>
+#include <LSC_output.h>
+#include <LSC_stats.h>
+#include <LSC_trace.h>
+
+#include "LSC_cell.h"
 
 const char *LSCb_cch = "\033[48;5;000m\033[38;5;015m ";
+const char *LSCb_rgbch = "\033[48;2;000;000;000m\033[38;2;255;255;255m ";
 
 void LSCb_init(LSCb_t *buf) {
 	buf -> colour = false;
+	buf -> truecolour = false;
+	buf -> glyph = 1;
 
 	buf -> height = 23;
 	buf -> width = 80;
@@ -37,33 +50,87 @@ void LSCb_init(LSCb_t *buf) {
 	buf -> validate = LSCB_VALIDATE_NONE;
 	buf -> cchs = LSCb_cch;
 	buf -> cch = ' ';
+	buf -> glyphs = NULL;
 
 	buf -> data = NULL;
 	buf -> zdata = NULL;
+
+	buf -> rows = NULL;
+	buf -> epoch = 0;
+	buf -> tiles = NULL;
+
+	buf -> wdata = NULL;
+	buf -> tdata = NULL;
+
+	buf -> alloc = LSCb_malloc;
+	buf -> free = LSCb_mfree;
+	buf -> ctx = NULL;
+
+	buf -> block = NULL;
+	buf -> capacity = 0;
+}
+
+/* A glyph wider than a byte is a UTF-8 sequence stored as it is, for buffers
+ * that are only ever written by a canvas. Blank cells in them, as in colour
+ * buffers, come from cchs rather than cch. */
+
+size_t LSCb_chwidth(const LSCb_t *buf) {
+	return (!buf -> colour? 0: buf -> truecolour? 38: 22) + buf -> glyph;
+}
+
+static size_t pad(size_t size) {
+	return (size + LSCB_ALIGN - 1) & ~(size_t) (LSCB_ALIGN - 1);
 }
 
 int LSCb_alloc(LSCb_t *buf) {
-	buf -> chwidth = buf -> colour? strlen(LSCb_cch): 1;
+	if(buf -> truecolour && buf -> cchs == LSCb_cch)
+		buf -> cchs = LSCb_rgbch;
 
-	buf -> data = malloc(buf -> chwidth * buf -> width * buf -> height + 1);
-	if(!buf -> data) {
-		if(LSCe_auto) perror("stdlib");
-		LSC_errno = LSC_MALLOC_ERR;
-		return LSCE_NOOP;
+	else if(!buf -> truecolour && buf -> cchs == LSCb_rgbch)
+		buf -> cchs = LSCb_cch;
+
+
+	buf -> chwidth = LSCb_chwidth(buf);
+
+	const size_t cells = buf -> width * buf -> height;
+	const size_t zsize = pad(sizeof(double) * cells);
+	const size_t rsize = pad(sizeof(uint64_t) * buf -> height)
+		+ pad(LSCb_tiles(buf -> width, buf -> height));
+
+	const size_t size = zsize + rsize + pad(buf -> chwidth * cells + 1);
+
+	if(size > buf -> capacity) {
+		if(buf -> block)
+			buf -> free(buf -> ctx, buf -> block, buf -> capacity);
+		buf -> capacity = 0;
+
+		buf -> block = buf -> alloc(buf -> ctx, size);
+		if(!buf -> block) {
+			if(LSCe_auto) perror("stdlib");
+			LSC_errno = LSC_MALLOC_ERR;
+
+			buf -> data = NULL;
+			buf -> zdata = NULL;
+			return LSCE_NOOP;
+		}
+
+		buf -> capacity = size;
 	}
 
-	buf -> zdata = malloc(sizeof(double) * buf -> width * buf -> height);
-	if(!buf -> zdata) {
-		if(LSCe_auto) perror("stdlib");
-		LSC_errno = LSC_MALLOC_ERR;
+	buf -> zdata = buf -> block;
+	buf -> rows = (uint64_t *) ((char *) buf -> block + zsize);
+	buf -> tiles = (uint8_t *) buf -> block + zsize
+		+ pad(sizeof(uint64_t) * buf -> height);
 
-		free(buf -> data);
-		buf -> data = NULL;
+	buf -> data = (char *) buf -> block + zsize + rsize;
+	LSCb_touch(buf, 0, buf -> height);
 
-		return LSCE_NOOP;
+	if(buf -> wdata) {
+		LSCb_heatoff(buf);
+		LSCb_heaton(buf);
 	}
 
-	if(buf -> colour)
+	if(buf -> chwidth > 1)
 		for(size_t i = 0; i < buf -> width * buf -> height; i++)
 			memcpy(&(buf -> data[i * buf -> chwidth]),
 				buf -> cchs, buf -> chwidth);
@@ -78,7 +145,10 @@ int LSCb_alloc(LSCb_t *buf) {
 }
 
 void LSCb_clear(LSCb_t *buf) {
-	if(buf -> colour)
+	LSCX_BEGIN("clear");
+	LSCS_ADD(clears, 1);
+
+	if(buf -> chwidth > 1)
 		for(size_t i = 0; i < buf -> width * buf -> height; i++)
 			memcpy(&(buf -> data[i * buf -> chwidth]),
 				buf -> cchs, buf -> chwidth);
@@ -87,63 +157,278 @@ void LSCb_clear(LSCb_t *buf) {
 
 	for(size_t i = 0; i < buf -> width * buf -> height; i++)
 		buf -> zdata[i] = -DBL_MAX;
+
+	LSCb_touch(buf, 0, buf -> height);
+	LSCb_heatclear(buf);
+	LSCX_END("clear");
+}
+
+void LSCb_touch(LSCb_t *buf, size_t y, size_t height) {
+	LSCb_dirty(buf, 0, y, buf -> width, height);
 }
 
 void LSCb_free(LSCb_t *buf) {
-	free(buf -> data);
-	buf -> data = NULL;
+	if(buf -> block) buf -> free(buf -> ctx, buf -> block, buf -> capacity);
+	buf -> block = NULL;
+	buf -> capacity = 0;
 
-	free(buf -> zdata);
+	buf -> data = NULL;
 	buf -> zdata = NULL;
+	buf -> rows = NULL;
+	buf -> tiles = NULL;
+
+	LSCb_heatoff(buf);
 	return;
 }
 
+static void move(char *to, const char *from, size_t rows, size_t len,
+	size_t tstride, size_t fstride)
+{
+	for(size_t i = rows; i-- > 0;) {
+		char *dst = to + i * tstride;
+		const char *src = from + i * fstride;
+		if((uintptr_t) dst > (uintptr_t) src) memmove(dst, src, len);
+	}
+
+	for(size_t i = 0; i < rows; i++) {
+		char *dst = to + i * tstride;
+		const char *src = from + i * fstride;
+		if((uintptr_t) dst < (uintptr_t) src) memmove(dst, src, len);
+	}
+}
+
+int LSCb_resize(LSCb_t *buf, size_t width, size_t height) {
+	if(!buf -> block) {
+		buf -> width = width;
+		buf -> height = height;
+		return LSCb_alloc(buf);
+	}
+
+	const size_t cells = width * height;
+	const size_t zsize = pad(sizeof(double) * cells);
+	const size_t rsize = pad(sizeof(uint64_t) * height)
+		+ pad(LSCb_tiles(width, height));
+
+	const size_t size = zsize + rsize + pad(buf -> chwidth * cells + 1);
+
+	char *block = buf -> block;
+	if(size > buf -> capacity) {
+		block = buf -> alloc(buf -> ctx, size);
+		if(!block) {
+			if(LSCe_auto) perror("stdlib");
+			LSC_errno = LSC_MALLOC_ERR;
+			return LSCE_NOOP;
+		}
+	}
+
+	LSCX_BEGIN("resize");
+
+	const size_t cw = buf -> chwidth, dw = sizeof(double);
+	const size_t ow = buf -> width;
+	const size_t kw = width < buf -> width? width: buf -> width;
+	const size_t kh = height < buf -> height? height: buf -> height;
+
+	char *zdata = block, *data = block + zsize + rsize;
+	char *old = (char *) buf -> zdata;
+
+	/* The planes may overlap their old selves inside the same block, so the
+	 * plane moving up has to go first to keep out of the other's way. The
+	 * row stamps and tiles in between are simply rewritten afterwards. */
+
+	if((uintptr_t) data >= (uintptr_t) buf -> data) {
+		move(data, buf -> data, kh, kw * cw, width * cw, ow * cw);
+		move(zdata, old, kh, kw * dw, width * dw, ow * dw);
+	}
+
+	else {
+		move(zdata, old, kh, kw * dw, width * dw, ow * dw);
+		move(data, buf -> data, kh, kw * cw, width * cw, ow * cw);
+	}
+
+	if(block != buf -> block) {
+		buf -> free(buf -> ctx, buf -> block, buf -> capacity);
+		buf -> block = block;
+		buf -> capacity = size;
+	}
+
+	buf -> zdata = (double *) zdata;
+	buf -> rows = (uint64_t *) (block + zsize);
+	buf -> tiles = (uint8_t *) block + zsize
+		+ pad(sizeof(uint64_t) * height);
+
+	buf -> data = data;
+	buf -> width = width;
+	buf -> height = height;
+	LSCb_touch(buf, 0, height);
+
+	for(size_t y = 0; y < height; y++) {
+		for(size_t x = y < kh? kw: 0; x < width; x++) {
+			if(cw > 1) memcpy(data + cw * (x + y * width),
+				buf -> cchs, cw);
+
+			else data[x + y * width] = buf -> cch;
+			buf -> zdata[x + y * width] = -DBL_MAX;
+		}
+	}
+
+	data[cw * cells] = 0;
+
+	if(buf -> wdata) {
+		LSCb_heatoff(buf);
+		LSCb_heaton(buf);
+	}
+
+	LSCX_END("resize");
+	return LSCE_OK;
+}
+
 void LSCb_set(LSCb_t *buf, size_t x, size_t y, char chr) {
+	LSCb_mark(buf, x, y);
 	buf -> data[buf -> chwidth * (x + y * buf -> width + 1) - 1] = chr;
 }
 
+/* Glyph IDs only become UTF-8 in the presenter, so a buffer with a glyph table
+ * is printed by encoding it in full with a presenter of its own. */
+
+static int expand(LSCo_t *out, LSCb_t *buf, int fd, size_t y) {
+	LSCo_init(out, fd);
+	out -> y = y;
+
+	if(LSCo_encode(out, buf) == LSCE_OK) return LSCE_OK;
+
+	LSCo_free(out);
+	return LSCE_NOOP;
+}
+
+static int print(LSCb_t *buf, size_t y) {
+	LSCo_t out;
+	if(expand(&out, buf, -1, y) != LSCE_OK) return LSCE_NOOP;
+
+	LSCX_BEGIN("print");
+	LSCS_START(start);
+
+	size_t ret = fwrite(out.data, 1, out.used, stdout);
+
+	LSCS_STOP(write_ns, start);
+	LSCX_END("print");
+
+	const bool ok = ret == out.used;
+	LSCo_free(&out);
+
+	if(!ok) {
+		if(LSCe_auto) perror("stdlib");
+		LSC_errno = LSC_PRINTF_ERR;
+		return LSCE_NOOP;
+	}
+
+	LSCS_ADD(sent, ret);
+	return LSCE_OK;
+}
+
 int LSCb_print(LSCb_t *buf, size_t y) {
+	if(buf -> glyphs) return print(buf, y);
+
+	LSCX_BEGIN("print");
+	LSCS_START(start);
+
 	int ret = printf("\033[%zu;1H%s", y, buf -> data);
+
+	LSCS_STOP(write_ns, start);
+	LSCX_END("print");
+
 	if(ret < 0) {
 		if(LSCe_auto) perror("stdlib");
 		LSC_errno = LSC_PRINTF_ERR;
 		return LSCE_NOOP;
 	}
 
+	LSCS_ADD(frames, 1);
+	LSCS_ADD(encoded, ret);
+	LSCS_ADD(sent, ret);
 	return LSCE_OK;
 }
 
-void LSCb_setcol(LSCb_t *buf, size_t x, size_t y, uint8_t fg, uint8_t bg) {
-	char chr = buf -> data[23 * (x + y * buf -> width) + 22];
+int LSCb_write(LSCb_t *buf, int fd, size_t y) {
+	if(buf -> glyphs) {
+		LSCo_t out;
+		if(expand(&out, buf, fd, y) != LSCE_OK) return LSCE_NOOP;
 
-	sprintf(buf -> data + 23 * (x + y * buf -> width),
-		"\033[48;5;%03um\033[38;5;%03um", bg, fg);
+		int ret = LSCo_flush(&out);
+		LSCo_free(&out);
+		return ret;
+	}
 
-	buf -> data[23 * (x + y * buf -> width) + 22] = chr;
-}
+	LSCX_BEGIN("encode");
+	LSCS_START(encoding);
 
-void LSCb_setfg(LSCb_t *buf, size_t x, size_t y, uint8_t fg) {
-	char chr = buf -> data[23 * (x + y * buf -> width) + 22];
+	char header[32];
+	struct iovec iov[2] = {
+		{header, snprintf(header, sizeof(header), "\033[%zu;1H", y)},
+		{buf -> data, buf -> chwidth * buf -> width * buf -> height}
+	};
 
-	sprintf(buf -> data + 23 * (x + y * buf -> width) + 11,
-		"\033[38;5;%03um", fg);
+	LSCS_STOP(encode_ns, encoding);
+	LSCX_END("encode");
 
-	buf -> data[23 * (x + y * buf -> width) + 22] = chr;
+	LSCS_ADD(encoded, iov[0].iov_len + iov[1].iov_len);
+	LSCS_ADD(frames, 1);
+
+	if(fd < 0) return LSCE_OK;
+
+	struct iovec *next = iov;
+	int count = 2;
+
+	LSCX_BEGIN("write");
+	LSCS_START(writing);
+
+	while(count) {
+		ssize_t ret = writev(fd, next, count);
+		if(ret == -1) {
+			if(errno == EINTR) continue;
+
+			LSCX_END("write");
+			if(LSCe_auto) perror("unistd");
+			LSC_errno = LSC_WRITE_ERR;
+			return LSCE_NOOP;
+		}
+
+		LSCS_ADD(sent, ret);
+		while(count && (size_t) ret >= next -> iov_len) {
+			ret -= next -> iov_len;
+			next++; count--;
+		}
+
+		if(count) {
+			next -> iov_base = (char *) next -> iov_base + ret;
+			next -> iov_len -= ret;
+		}
+	}
+
+	LSCS_STOP(write_ns, writing);
+	LSCX_END("write");
+	return LSCE_OK;
 }
 
-void LSCb_setbg(LSCb_t *buf, size_t x, size_t y, uint8_t bg) {
-	sprintf(buf -> data + 23 * (x + y * buf -> width),
-		"\033[48;5;%03um", bg);
+void LSCb_setcol(LSCb_t *buf, size_t x, size_t y, uint8_t fg, uint8_t bg) {
+	LSCb_mark(buf, x, y);
+	LSCc_col(buf -> data + 23 * (x + y * buf -> width), fg, bg);
+}
 
-	buf -> data[23 * (x + y * buf -> width) + 11] = '\033';
+void LSCb_setfg(LSCb_t *buf, size_t x, size_t y, uint8_t fg) {
+	LSCb_mark(buf, x, y);
+	LSCc_fg(buf -> data + 23 * (x + y * buf -> width) + 11, fg);
+}
+
+void LSCb_setbg(LSCb_t *buf, size_t x, size_t y, uint8_t bg) {
+	LSCb_mark(buf, x, y);
+	LSCc_bg(buf -> data + 23 * (x + y * buf -> width), bg);
 }
 
 void LSCb_setall(LSCb_t *buf, size_t x, size_t y,
 	char chr, uint8_t fg, uint8_t bg)
 {
-	sprintf(buf -> data + 23 * (x + y * buf -> width),
-		"\033[48;5;%03um\033[38;5;%03um", bg, fg);
-
+	LSCb_mark(buf, x, y);
+	LSCc_col(buf -> data + 23 * (x + y * buf -> width), fg, bg);
 	buf -> data[23 * (x + y * buf -> width) + 22] = chr;
 }
 
@@ -160,54 +445,152 @@ size_t LSCb_gety(LSCb_t *buf, double y) {
 }
 
 void LSCb_sets(LSCb_t *buf, size_t x, size_t y, const char *data) {
+	LSCb_mark(buf, x, y);
 	buf -> data[buf -> chwidth * (x + y * buf -> width + 1) - 1] = data[0];
 }
 
 void LSCb_setcols(LSCb_t *buf, size_t x, size_t y, const char *data) {
+	LSCb_mark(buf, x, y);
 	memcpy(buf -> data + 23 * (x + y * buf -> width), data, 22);
 }
 
 void LSCb_setfgs(LSCb_t *buf, size_t x, size_t y, const char *data) {
+	LSCb_mark(buf, x, y);
 	memcpy(buf -> data + 23 * (x + y * buf -> width) + 11, data, 11);
 }
 
 void LSCb_setbgs(LSCb_t *buf, size_t x, size_t y, const char *data) {
+	LSCb_mark(buf, x, y);
 	memcpy(buf -> data + 23 * (x + y * buf -> width), data, 11);
 }
 
 void LSCb_setalls(LSCb_t *buf, size_t x, size_t y, const char *data) {
+	LSCb_mark(buf, x, y);
 	memcpy(buf -> data + 23 * (x + y * buf -> width), data, 23);
 }
 
 void LSCb_setz(LSCb_t *buf, size_t x, size_t y, double z, char chr) {
-	if(buf -> zdata[x + y * buf -> width] > z) return;
+	if(LSCb_occluded(buf, x + y * buf -> width, z)) return;
 	LSCb_set(buf, x, y, chr);
 }
 
 void LSCb_setcolz(LSCb_t *buf, size_t x, size_t y, double z,
 	uint8_t fg, uint8_t bg)
 {
-	if(buf -> zdata[x + y * buf -> width] > z) return;
+	if(LSCb_occluded(buf, x + y * buf -> width, z)) return;
 	LSCb_setcol(buf, x, y, fg, bg);
 }
 
 void LSCb_setfgz(LSCb_t *buf, size_t x, size_t y, double z, uint8_t fg) {
-	if(buf -> zdata[x + y * buf -> width] > z) return;
+	if(LSCb_occluded(buf, x + y * buf -> width, z)) return;
 	LSCb_setfg(buf, x, y, fg);
 }
 
 void LSCb_setbgz(LSCb_t *buf, size_t x, size_t y, double z, uint8_t bg) {
-	if(buf -> zdata[x + y * buf -> width] > z) return;
+	if(LSCb_occluded(buf, x + y * buf -> width, z)) return;
 	LSCb_setbg(buf, x, y, bg);
 }
 
 void LSCb_setallz(LSCb_t *buf, size_t x, size_t y, double z,
 	char chr, uint8_t fg, uint8_t bg)
 {
-	if(buf -> zdata[x + y * buf -> width] > z) return;
+	if(LSCb_occluded(buf, x + y * buf -> width, z)) return;
 	LSCb_setall(buf, x, y, chr, fg, bg);
 }
 
+void LSCb_setrgb(LSCb_t *buf, size_t x, size_t y, uint32_t fg, uint32_t bg) {
+	LSCb_mark(buf, x, y);
+	LSCc_rgb(buf -> data + 39 * (x + y * buf -> width), fg, bg);
+}
+
+void LSCb_setfgrgb(LSCb_t *buf, size_t x, size_t y, uint32_t fg) {
+	LSCb_mark(buf, x, y);
+	LSCc_rgbfg(buf -> data + 39 * (x + y * buf -> width) + 19, fg);
+}
+
+void LSCb_setbgrgb(LSCb_t *buf, size_t x, size_t y, uint32_t bg) {
+	LSCb_mark(buf, x, y);
+	LSCc_rgbbg(buf -> data + 39 * (x + y * buf -> width), bg);
+}
+
+void LSCb_setallrgb(LSCb_t *buf, size_t x, size_t y,
+	char chr, uint32_t fg, uint32_t bg)
+{
+	LSCb_mark(buf, x, y);
+	LSCc_rgb(buf -> data + 39 * (x + y * buf -> width), fg, bg);
+	buf -> data[39 * (x + y * buf -> width) + 38] = chr;
+}
+
+void LSCb_setrgbz(LSCb_t *buf, size_t x, size_t y, double z,
+	uint32_t fg, uint32_t bg)
+{
+	if(LSCb_occluded(buf, x + y * buf -> width, z)) return;
+	LSCb_setrgb(buf, x, y, fg, bg);
+}
+
+void LSCb_setfgrgbz(LSCb_t *buf, size_t x, size_t y, double z, uint32_t fg) {
+	if(LSCb_occluded(buf, x + y * buf -> width, z)) return;
+	LSCb_setfgrgb(buf, x, y, fg);
+}
+
+void LSCb_setbgrgbz(LSCb_t *buf, size_t x, size_t y, double z, uint32_t bg) {
+	if(LSCb_occluded(buf, x + y * buf -> width, z)) return;
+	LSCb_setbgrgb(buf, x, y, bg);
+}
+
+void LSCb_setallrgbz(LSCb_t *buf, size_t x, size_t y, double z,
+	char chr, uint32_t fg, uint32_t bg)
+{
+	if(LSCb_occluded(buf, x + y * buf -> width, z)) return;
+	LSCb_setallrgb(buf, x, y, chr, fg, bg);
+}
+
+void LSCb_setrgbv(LSCb_t *buf, size_t x, size_t y, uint32_t fg, uint32_t bg) {
+	if(x < buf -> width && y < buf -> height)
+		LSCb_setrgb(buf, x, y, fg, bg);
+}
+
+void LSCb_setfgrgbv(LSCb_t *buf, size_t x, size_t y, uint32_t fg) {
+	if(x < buf -> width && y < buf -> height) LSCb_setfgrgb(buf, x, y, fg);
+}
+
+void LSCb_setbgrgbv(LSCb_t *buf, size_t x, size_t y, uint32_t bg) {
+	if(x < buf -> width && y < buf -> height) LSCb_setbgrgb(buf, x, y, bg);
+}
+
+void LSCb_setallrgbv(LSCb_t *buf, size_t x, size_t y,
+	char chr, uint32_t fg, uint32_t bg)
+{
+	if(x < buf -> width && y < buf -> height)
+		LSCb_setallrgb(buf, x, y, chr, fg, bg);
+}
+
+void LSCb_setrgbzv(LSCb_t *buf, size_t x, size_t y, double z,
+	uint32_t fg, uint32_t bg)
+{
+	if(x < buf -> width && y < buf -> height)
+		LSCb_setrgbz(buf, x, y, z, fg, bg);
+}
+
+void LSCb_setfgrgbzv(LSCb_t *buf, size_t x, size_t y, double z, uint32_t fg)
+{
+	if(x < buf -> width && y < buf -> height)
+		LSCb_setfgrgbz(buf, x, y, z, fg);
+}
+
+void LSCb_setbgrgbzv(LSCb_t *buf, size_t x, size_t y, double z, uint32_t bg)
+{
+	if(x < buf -> width && y < buf -> height)
+		LSCb_setbgrgbz(buf, x, y, z, bg);
+}
+
+void LSCb_setallrgbzv(LSCb_t *buf, size_t x, size_t y, double z,
+	char chr, uint32_t fg, uint32_t bg)
+{
+	if(x < buf -> width && y < buf -> height)
+		LSCb_setallrgbz(buf, x, y, z, chr, fg, bg);
+}
+
 size_t LSCb_getxz(LSCb_t *buf, double x, double z) {
 	return LSCb_getx(buf, x * -buf -> screen / (z - buf -> screen));
 }
@@ -217,7 +600,7 @@ size_t LSCb_getyz(LSCb_t *buf, double y, double z) {
 }
 
 void LSCb_setsz(LSCb_t *buf, size_t x, size_t y, double z, const char *data) {
-	if(buf -> zdata[x + y * buf -> width] > z) return;
+	if(LSCb_occluded(buf, x + y * buf -> width, z)) return;
 	LSCb_sets(buf, x, y, data);
 	buf -> zdata[x + y * buf -> width] = z;
 }
@@ -225,19 +608,19 @@ void LSCb_setsz(LSCb_t *buf, size_t x, size_t y, double z, const char *data) {
 void LSCb_setcolsz(LSCb_t *buf, size_t x, size_t y, double z,
 	const char *data)
 {
-	if(buf -> zdata[x + y * buf -> width] > z) return;
+	if(LSCb_occluded(buf, x + y * buf -> width, z)) return;
 	LSCb_setcols(buf, x, y, data);
 	buf -> zdata[x + y * buf -> width] = z;
 }
 
 void LSCb_setfgsz(LSCb_t *buf, size_t x, size_t y, double z, const char *data) {
-	if(buf -> zdata[x + y * buf -> width] > z) return;
+	if(LSCb_occluded(buf, x + y * buf -> width, z)) return;
 	LSCb_setfgs(buf, x, y, data);
 	buf -> zdata[x + y * buf -> width] = z;
 }
 
 void LSCb_setbgsz(LSCb_t *buf, size_t x, size_t y, double z, const char *data) {
-	if(buf -> zdata[x + y * buf -> width] > z) return;
+	if(LSCb_occluded(buf, x + y * buf -> width, z)) return;
 	LSCb_setbgs(buf, x, y, data);
 	buf -> zdata[x + y * buf -> width] = z;
 }
@@ -245,7 +628,7 @@ void LSCb_setbgsz(LSCb_t *buf, size_t x, size_t y, double z, const char *data) {
 void LSCb_setallsz(LSCb_t *buf, size_t x, size_t y, double z,
 	const char *data)
 {
-	if(buf -> zdata[x + y * buf -> width] > z) return;
+	if(LSCb_occluded(buf, x + y * buf -> width, z)) return;
 	LSCb_setalls(buf, x, y, data);
 	buf -> zdata[x + y * buf -> width] = z;
 }
@@ -0,0 +1,119 @@
+/* libScricon: The Simple Graphical Console Library
+ * Copyright (C) 2021-2022 Jyothiraditya Nellakra
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <LSC_buffer.h>
+
+static size_t cols(size_t width) {
+	return (width + LSCB_TILE_W - 1) / LSCB_TILE_W;
+}
+
+static size_t lines(size_t height) {
+	return (height + LSCB_TILE_H - 1) / LSCB_TILE_H;
+}
+
+size_t LSCb_tiles(size_t width, size_t height) {
+	return cols(width) * lines(height);
+}
+
+void LSCb_dirty(LSCb_t *buf, size_t x, size_t y,
+	size_t width, size_t height)
+{
+	if(!buf -> rows || !width || !height) return;
+	for(size_t i = y; i < y + height; i++) buf -> rows[i] = buf -> epoch;
+
+	const size_t tx = x / LSCB_TILE_W;
+	const size_t tw = (x + width - 1) / LSCB_TILE_W - tx + 1;
+
+	const size_t top = y / LSCB_TILE_H;
+	const size_t bottom = (y + height - 1) / LSCB_TILE_H;
+
+	for(size_t ty = top; ty <= bottom; ty++)
+		memset(buf -> tiles + tx + ty * cols(buf -> width), 1, tw);
+}
+
+static void merge(LSCb_rect_t *into, const LSCb_rect_t *rect) {
+	size_t right = into -> x + into -> width;
+	size_t bottom = into -> y + into -> height;
+
+	if(rect -> x + rect -> width > right) right = rect -> x + rect -> width;
+	if(rect -> y + rect -> height > bottom)
+		bottom = rect -> y + rect -> height;
+
+	if(rect -> x < into -> x) into -> x = rect -> x;
+	if(rect -> y < into -> y) into -> y = rect -> y;
+
+	into -> width = right - into -> x;
+	into -> height = bottom - into -> y;
+}
+
+static LSCb_rect_t run(LSCb_t *buf, size_t tx, size_t end, size_t ty) {
+	size_t right = end * LSCB_TILE_W, bottom = (ty + 1) * LSCB_TILE_H;
+	if(right > buf -> width) right = buf -> width;
+	if(bottom > buf -> height) bottom = buf -> height;
+
+	const size_t x = tx * LSCB_TILE_W, y = ty * LSCB_TILE_H;
+	return (LSCb_rect_t) {x, y, right - x, bottom - y};
+}
+
+static bool above(const LSCb_rect_t *rect, const LSCb_rect_t *next) {
+	return rect -> x == next -> x && rect -> width == next -> width
+		&& rect -> y + rect -> height == next -> y;
+}
+
+/* Each row of tiles is split into runs of dirty tiles, and a run is folded
+ * into the rectangle directly above it if that spans exactly the same
+ * columns. Once the caller's array is full, everything else is merged into
+ * its last rectangle, so the result always covers every dirty tile. */
+
+size_t LSCb_rects(LSCb_t *buf, LSCb_rect_t *rects, size_t count) {
+	if(!buf -> tiles || !count) return 0;
+
+	const size_t tw = cols(buf -> width), th = lines(buf -> height);
+	size_t n = 0;
+
+	for(size_t ty = 0; ty < th; ty++) {
+		const uint8_t *row = buf -> tiles + ty * tw;
+
+		for(size_t tx = 0; tx < tw; tx++) {
+			if(!row[tx]) continue;
+
+			size_t end = tx;
+			while(end < tw && row[end]) end++;
+
+			LSCb_rect_t rect = run(buf, tx, end, ty);
+			tx = end;
+
+			size_t i = 0;
+			while(i < n && !above(&rects[i], &rect)) i++;
+
+			if(i < n) rects[i].height += rect.height;
+			else if(n < count) rects[n++] = rect;
+			else merge(&rects[count - 1], &rect);
+		}
+	}
+
+	return n;
+}
+
+void LSCb_clean(LSCb_t *buf) {
+	if(!buf -> tiles) return;
+	memset(buf -> tiles, 0, LSCb_tiles(buf -> width, buf -> height));
+}
@@ -20,7 +20,7 @@
 
 #include <LSC_error.h>
 
-#define MAX_ERR 7
+#define MAX_ERR 14
 
 bool LSCe_auto = true;
 thread_local int LSC_errno;
@@ -33,7 +33,14 @@ static const char *errors[MAX_ERR + 1] = {
 	"Mutex unlocking error.",
 	"Thread creation error.",
 	"Thread joining error.",
-	"Error printing data."
+	"Error printing data.",
+	"Error writing data.",
+	"Error querying the terminal.",
+	"Shared memory error.",
+	"Error setting file flags.",
+	"Error reading data.",
+	"Unsupported or malformed image data.",
+	"Invalid or incomplete UTF-8 glyph."
 };
 
 const char *LSC_strerror(int err) {
@@ -0,0 +1,285 @@
+/* libScricon: The Simple Graphical Console Library
+ * Copyright (C) 2021-2022 Jyothiraditya Nellakra
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <threads.h>
+
+#include <poll.h>
+
+#include <LSC_buffer.h>
+#include <LSC_error.h>
+#include <LSC_fanout.h>
+#include <LSC_output.h>
+
+/* Each view has a writer thread that waits for a newer generation, encodes it
+ * against its own shadow frame while holding the lock, and writes the result
+ * after letting go. A view that is still writing simply misses generations,
+ * so slow viewers get coalesced diffs without holding anyone else up. */
+
+static int flush(LSCo_t *out) {
+	struct pollfd pfd = {out -> fd, POLLOUT, 0};
+	int ret = LSCo_flush(out);
+
+	while(ret == LSCE_OK && out -> used) {
+		if(poll(&pfd, 1, -1) == -1 && errno != EINTR) break;
+		ret = LSCo_flush(out);
+	}
+
+	return ret;
+}
+
+static int writer(void *arg) {
+	LSCf_view_t *view = arg;
+	LSCf_t *fan = view -> fan;
+
+	mtx_lock(&fan -> lock);
+
+	while(true) {
+		while(!view -> stop && view -> seen == fan -> generation)
+			cnd_wait(&fan -> cond, &fan -> lock);
+
+		if(view -> stop) break;
+
+		view -> out.cached = fan -> cached;
+		view -> out.cache = fan -> cache;
+
+		int ret = LSCo_encode(&view -> out, &fan -> frame);
+		view -> seen = fan -> generation;
+
+		mtx_unlock(&fan -> lock);
+		if(ret == LSCE_OK) ret = flush(&view -> out);
+		mtx_lock(&fan -> lock);
+
+		if(ret != LSCE_OK) {
+			view -> failed = true;
+			break;
+		}
+	}
+
+	mtx_unlock(&fan -> lock);
+	return 0;
+}
+
+int LSCf_init(LSCf_t *fan) {
+	if(mtx_init(&fan -> lock, mtx_plain) != thrd_success) {
+		LSC_errno = LSC_MTX_INIT_ERR;
+		return LSCE_NOOP;
+	}
+
+	if(cnd_init(&fan -> cond) != thrd_success) {
+		mtx_destroy(&fan -> lock);
+		LSC_errno = LSC_MTX_INIT_ERR;
+		return LSCE_NOOP;
+	}
+
+	LSCb_init(&fan -> frame);
+	fan -> generation = 0;
+	fan -> sync = false;
+
+	fan -> source = NULL;
+	fan -> seen = 0;
+
+	fan -> cached = 0;
+	fan -> cache = NULL;
+
+	fan -> count = 0;
+	fan -> slots = 0;
+	fan -> views = NULL;
+	return LSCE_OK;
+}
+
+static void stop(LSCf_t *fan, size_t i) {
+	LSCf_view_t *view = fan -> views[i];
+
+	mtx_lock(&fan -> lock);
+	view -> stop = true;
+	cnd_broadcast(&fan -> cond);
+	mtx_unlock(&fan -> lock);
+
+	thrd_join(view -> thread, NULL);
+	LSCo_free(&view -> out);
+	free(view);
+
+	fan -> views[i] = fan -> views[--fan -> count];
+}
+
+void LSCf_free(LSCf_t *fan) {
+	while(fan -> count) stop(fan, fan -> count - 1);
+
+	free(fan -> views);
+	fan -> views = NULL;
+	fan -> slots = 0;
+
+	LSCo_uncache(fan -> cache, fan -> cached);
+	free(fan -> cache);
+	fan -> cache = NULL;
+	fan -> cached = 0;
+
+	LSCb_free(&fan -> frame);
+	cnd_destroy(&fan -> cond);
+	mtx_destroy(&fan -> lock);
+}
+
+int LSCf_add(LSCf_t *fan, int fd) {
+	if(fan -> count == fan -> slots) {
+		size_t slots = fan -> slots? fan -> slots * 2: 8;
+		LSCf_view_t **views = realloc(fan -> views,
+			sizeof(LSCf_view_t *) * slots);
+
+		if(!views) {
+			if(LSCe_auto) perror("stdlib");
+			LSC_errno = LSC_MALLOC_ERR;
+			return LSCE_NOOP;
+		}
+
+		fan -> views = views;
+		fan -> slots = slots;
+	}
+
+	LSCf_view_t *view = malloc(sizeof(LSCf_view_t));
+	if(!view) {
+		if(LSCe_auto) perror("stdlib");
+		LSC_errno = LSC_MALLOC_ERR;
+		return LSCE_NOOP;
+	}
+
+	LSCo_init(&view -> out, fd);
+	view -> out.sync = fan -> sync;
+	view -> fan = fan;
+	view -> seen = 0;
+	view -> stop = false;
+	view -> failed = false;
+
+	if(thrd_create(&view -> thread, writer, view) != thrd_success) {
+		free(view);
+		LSC_errno = LSC_THREAD_CREATE_ERR;
+		return LSCE_NOOP;
+	}
+
+	fan -> views[fan -> count++] = view;
+	return LSCE_OK;
+}
+
+int LSCf_remove(LSCf_t *fan, int fd) {
+	for(size_t i = 0; i < fan -> count; i++) {
+		if(fan -> views[i] -> out.fd != fd) continue;
+
+		stop(fan, i);
+		return LSCE_OK;
+	}
+
+	return LSCE_NOOP;
+}
+
+int LSCf_reap(LSCf_t *fan) {
+	for(size_t i = 0; i < fan -> count; i++) {
+		mtx_lock(&fan -> lock);
+		bool failed = fan -> views[i] -> failed;
+		mtx_unlock(&fan -> lock);
+
+		if(!failed) continue;
+
+		int fd = fan -> views[i] -> out.fd;
+		stop(fan, i);
+		return fd;
+	}
+
+	return -1;
+}
+
+static int reshape(LSCf_t *fan, LSCb_t *buf) {
+	LSCb_t *frame = &fan -> frame;
+
+	frame -> colour = buf -> colour;
+	frame -> truecolour = buf -> truecolour;
+	frame -> glyph = buf -> glyph;
+	frame -> cchs = buf -> cchs;
+	frame -> cch = buf -> cch;
+	frame -> glyphs = buf -> glyphs;
+	frame -> width = buf -> width;
+	frame -> height = buf -> height;
+	fan -> source = NULL;
+
+	LSCo_uncache(fan -> cache, fan -> cached);
+	fan -> cached = 0;
+
+	LSCo_row_t *cache = realloc(fan -> cache,
+		sizeof(LSCo_row_t) * buf -> height);
+
+	if(!cache) {
+		if(LSCe_auto) perror("stdlib");
+		LSC_errno = LSC_MALLOC_ERR;
+		return LSCE_NOOP;
+	}
+
+	fan -> cache = cache;
+	for(size_t i = 0; i < buf -> height; i++) {
+		cache[i].valid = false;
+		cache[i].size = 0;
+		cache[i].data = NULL;
+	}
+
+	if(LSCb_alloc(frame) != LSCE_OK) return LSCE_NOOP;
+
+	fan -> cached = buf -> height;
+	return LSCE_OK;
+}
+
+/* Only rows the source has stamped since the last publish are copied over,
+ * and they are stamped in the shared frame in turn, so the viewers can skip
+ * everything else without looking at it. */
+
+int LSCf_publish(LSCf_t *fan, LSCb_t *buf) {
+	LSCb_t *frame = &fan -> frame;
+	mtx_lock(&fan -> lock);
+
+	if(!frame -> data || frame -> chwidth != buf -> chwidth
+		|| frame -> glyphs != buf -> glyphs
+		|| frame -> width != buf -> width
+		|| frame -> height != buf -> height)
+	{
+		if(reshape(fan, buf) != LSCE_OK) {
+			LSCb_free(frame);
+			mtx_unlock(&fan -> lock);
+			return LSCE_NOOP;
+		}
+	}
+
+	const size_t len = buf -> chwidth * buf -> width;
+	const bool stamped = buf -> rows && fan -> source == buf;
+
+	for(size_t y = 0; y < buf -> height; y++) {
+		if(stamped && buf -> rows[y] < fan -> seen) continue;
+
+		memcpy(frame -> data + y * len, buf -> data + y * len, len);
+		LSCb_touch(frame, y, 1);
+	}
+
+	fan -> source = buf;
+	if(buf -> rows) fan -> seen = ++buf -> epoch;
+
+	fan -> generation++;
+	cnd_broadcast(&fan -> cond);
+
+	mtx_unlock(&fan -> lock);
+	return LSCE_OK;
+}
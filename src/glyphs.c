@@ -0,0 +1,95 @@
+/* libScricon: The Simple Graphical Console Library
+ * Copyright (C) 2021-2022 Jyothiraditya Nellakra
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <LSC_error.h>
+#include <LSC_glyphs.h>
+
+/* Box drawing characters in the order of the LSCG_ constants, first light,
+ * then double and then heavy, followed by the shades and block elements. */
+
+static const struct { uint8_t id; const char *utf8; } defaults[] = {
+	{0x80, "─"}, {0x81, "│"}, {0x82, "┌"}, {0x83, "┐"}, {0x84, "└"},
+	{0x85, "┘"}, {0x86, "├"}, {0x87, "┤"}, {0x88, "┬"}, {0x89, "┴"},
+	{0x8a, "┼"},
+
+	{0x90, "═"}, {0x91, "║"}, {0x92, "╔"}, {0x93, "╗"}, {0x94, "╚"},
+	{0x95, "╝"}, {0x96, "╠"}, {0x97, "╣"}, {0x98, "╦"}, {0x99, "╩"},
+	{0x9a, "╬"},
+
+	{0xa0, "━"}, {0xa1, "┃"}, {0xa2, "┏"}, {0xa3, "┓"}, {0xa4, "┗"},
+	{0xa5, "┛"}, {0xa6, "┣"}, {0xa7, "┫"}, {0xa8, "┳"}, {0xa9, "┻"},
+	{0xaa, "╋"},
+
+	{0xb0, "░"}, {0xb1, "▒"}, {0xb2, "▓"}, {0xb3, "█"}, {0xb4, "▀"},
+	{0xb5, "▄"}, {0xb6, "▌"}, {0xb7, "▐"}
+};
+
+/* The ranges a terminal draws two columns wide: Hangul Jamo, the CJK blocks
+ * from the radicals to Yi, Hangul syllables, the compatibility ideographs and
+ * forms, fullwidth forms, the common emoji blocks and the supplementary
+ * ideographic planes. */
+
+static const uint32_t ranges[][2] = {
+	{0x1100, 0x115f}, {0x2e80, 0x303e}, {0x3041, 0xa4cf},
+	{0xac00, 0xd7a3}, {0xf900, 0xfaff}, {0xfe30, 0xfe4f},
+	{0xff00, 0xff60}, {0xffe0, 0xffe6}, {0x1f300, 0x1f64f},
+	{0x1f900, 0x1f9ff}, {0x20000, 0x3fffd}
+};
+
+static bool wide(uint32_t point) {
+	for(size_t i = 0; i < sizeof(ranges) / sizeof(ranges[0]); i++)
+		if(point >= ranges[i][0] && point <= ranges[i][1]) return true;
+
+	return false;
+}
+
+void LSCg_init(LSCg_t *table) {
+	for(size_t i = 0; i < 256; i++) {
+		table -> len[i] = 1;
+		table -> wide[i] = false;
+		table -> utf8[i][0] = (char) i;
+	}
+
+	for(size_t i = 0; i < sizeof(defaults) / sizeof(defaults[0]); i++)
+		LSCg_set(table, defaults[i].id, defaults[i].utf8);
+}
+
+int LSCg_set(LSCg_t *table, uint8_t id, const char *utf8) {
+	const uint8_t *bytes = (const uint8_t *) utf8;
+	size_t len = bytes[0] < 0x80? 1: bytes[0] >> 5 == 0x06? 2:
+		bytes[0] >> 4 == 0x0e? 3: bytes[0] >> 3 == 0x1e? 4: 0;
+
+	uint32_t point = len == 1? bytes[0]: bytes[0] & (0x7f >> len);
+	for(size_t i = 1; i < len; i++) {
+		if(bytes[i] >> 6 != 0x02) { len = 0; break; }
+		point = point << 6 | (bytes[i] & 0x3f);
+	}
+
+	if(!len || utf8[len]) {
+		LSC_errno = LSC_GLYPH_ERR;
+		return LSCE_NOOP;
+	}
+
+	memcpy(table -> utf8[id], utf8, len);
+	table -> len[id] = len;
+	table -> wide[id] = wide(point);
+	return LSCE_OK;
+}
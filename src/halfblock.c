@@ -0,0 +1,154 @@
+/* libScricon: The Simple Graphical Console Library
+ * Copyright (C) 2021-2022 Jyothiraditya Nellakra
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <LSC_buffer.h>
+#include <LSC_colour.h>
+#include <LSC_error.h>
+#include <LSC_halfblock.h>
+#include <LSC_quantize.h>
+#include <LSC_trace.h>
+
+const char *LSCh_blank = "\033[48;5;016m\033[38;5;016m█";
+
+/* Indexed by which quarters are in the foreground colour: bit 0 is the top
+ * left, bit 1 the top right, bit 2 the bottom left and bit 3 the bottom right.
+ * Every block element is three bytes of UTF-8, so the cells stay one size. */
+
+static const char glyphs[16][4] = {
+	"█", "▘", "▝", "▀",
+	"▖", "▌", "▞", "▛",
+	"▗", "▚", "▐", "▜",
+	"▄", "▙", "▟", "█"
+};
+
+void LSCh_init(LSCh_t *canvas) {
+	canvas -> quad = false;
+	canvas -> height = 23;
+	canvas -> width = 80;
+
+	LSCb_init(&canvas -> grid);
+	canvas -> grid.cch = 16;
+
+	LSCb_init(&canvas -> frame);
+	canvas -> frame.colour = true;
+	canvas -> frame.glyph = 3;
+	canvas -> frame.cchs = LSCh_blank;
+
+	canvas -> seen = 0;
+}
+
+int LSCh_alloc(LSCh_t *canvas) {
+	LSCq_init();
+
+	canvas -> grid.width = canvas -> width * (canvas -> quad? 2: 1);
+	canvas -> grid.height = canvas -> height * 2;
+	if(LSCb_alloc(&canvas -> grid) != LSCE_OK) return LSCE_NOOP;
+
+	canvas -> frame.width = canvas -> width;
+	canvas -> frame.height = canvas -> height;
+	if(LSCb_alloc(&canvas -> frame) != LSCE_OK) {
+		LSCb_free(&canvas -> grid);
+		return LSCE_NOOP;
+	}
+
+	canvas -> seen = 0;
+	return LSCE_OK;
+}
+
+void LSCh_free(LSCh_t *canvas) {
+	LSCb_free(&canvas -> grid);
+	LSCb_free(&canvas -> frame);
+}
+
+static uint32_t distance(uint8_t a, uint8_t b) {
+	const uint32_t x = LSCq_palette[a], y = LSCq_palette[b];
+	uint32_t dist = 0;
+
+	for(int shift = 0; shift < 24; shift += 8) {
+		const int d = (int) (x >> shift & 0xff)
+			- (int) (y >> shift & 0xff);
+
+		dist += d * d;
+	}
+
+	return dist;
+}
+
+/* A cell can only show two colours, so the top left pixel's colour becomes
+ * the foreground and the most common of the others the background. Any pixel
+ * in a third or fourth colour goes with whichever of the two is closer. */
+
+static void cell(char *data, const uint8_t px[4]) {
+	const uint8_t fg = px[0];
+	uint8_t bg = fg;
+	unsigned most = 0;
+
+	for(size_t i = 1; i < 4; i++) {
+		if(px[i] == fg) continue;
+
+		unsigned count = 0;
+		for(size_t j = 1; j < 4; j++) count += px[j] == px[i];
+		if(count > most) { most = count; bg = px[i]; }
+	}
+
+	unsigned mask = 0;
+	for(size_t i = 0; i < 4; i++) {
+		if(px[i] == fg || (px[i] != bg
+			&& distance(px[i], fg) <= distance(px[i], bg)))
+		{ mask |= 1u << i; }
+	}
+
+	LSCc_col(data, fg, bg);
+	memcpy(data + 22, glyphs[mask], 3);
+}
+
+void LSCh_resolve(LSCh_t *canvas) {
+	LSCX_BEGIN("resolve");
+
+	LSCb_t *grid = &canvas -> grid, *frame = &canvas -> frame;
+	const size_t stride = grid -> width, cw = frame -> chwidth;
+
+	for(size_t y = 0; y < frame -> height; y++) {
+		const uint64_t *rows = grid -> rows + 2 * y;
+		const uint64_t seen = canvas -> seen;
+		if(rows[0] < seen && rows[1] < seen) continue;
+
+		const uint8_t *top = (uint8_t *) grid -> data + 2 * y * stride;
+		const uint8_t *bottom = top + stride;
+		char *data = frame -> data + y * frame -> width * cw;
+
+		for(size_t x = 0; x < frame -> width; x++, data += cw) {
+			const size_t l = canvas -> quad? 2 * x: x;
+			const size_t r = canvas -> quad? 2 * x + 1: x;
+
+			const uint8_t px[4] = {
+				top[l], top[r], bottom[l], bottom[r]
+			};
+
+			cell(data, px);
+		}
+
+		LSCb_touch(frame, y, 1);
+	}
+
+	canvas -> seen = ++grid -> epoch;
+	LSCX_END("resolve");
+}
@@ -0,0 +1,145 @@
+/* libScricon: The Simple Graphical Console Library
+ * Copyright (C) 2021-2022 Jyothiraditya Nellakra
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <LSC_buffer.h>
+#include <LSC_colour.h>
+#include <LSC_error.h>
+
+static const uint8_t ramp[10] = {
+	232, 19, 27, 39, 48, 118, 226, 214, 202, 196
+};
+
+static const uint32_t stops[10] = {
+	0x080808, 0x0000af, 0x005fff, 0x00afff, 0x00ff87,
+	0x87ff00, 0xffff00, 0xffaf00, 0xff5f00, 0xff0000
+};
+
+static const char glyphs[11] = ".123456789+";
+
+/* Truecolour buffers get a continuous ramp through the same colours instead,
+ * stretched over the range of counts actually present in the frame. */
+
+static uint32_t smooth(uint32_t count, uint32_t most) {
+	if(!most) return stops[0];
+
+	const uint64_t pos = (uint64_t) count * 9 * 256 / most;
+	const size_t i = pos >> 8 < 9? pos >> 8: 8;
+	const uint32_t t = pos - i * 256, from = stops[i], to = stops[i + 1];
+
+	uint32_t rgb = 0;
+	for(int shift = 0; shift < 24; shift += 8) {
+		int a = from >> shift & 0xff, b = to >> shift & 0xff;
+		rgb |= (uint32_t) (a + (b - a) * (int) t / 256) << shift;
+	}
+
+	return rgb;
+}
+
+int LSCb_heaton(LSCb_t *buf) {
+	if(buf -> wdata) return LSCE_OK;
+
+	const size_t size = buf -> width * buf -> height;
+	buf -> wdata = calloc(2 * size, sizeof(uint32_t));
+	if(!buf -> wdata) {
+		if(LSCe_auto) perror("stdlib");
+		LSC_errno = LSC_MALLOC_ERR;
+		return LSCE_NOOP;
+	}
+
+	buf -> tdata = buf -> wdata + size;
+	return LSCE_OK;
+}
+
+void LSCb_heatoff(LSCb_t *buf) {
+	free(buf -> wdata);
+	buf -> wdata = NULL;
+	buf -> tdata = NULL;
+}
+
+void LSCb_heatclear(LSCb_t *buf) {
+	if(!buf -> wdata) return;
+	memset(buf -> wdata, 0,
+		2 * sizeof(uint32_t) * buf -> width * buf -> height);
+}
+
+void LSCb_heatmap(LSCb_t *buf, bool tests) {
+	if(!buf -> wdata) return;
+	const uint32_t *counts = tests? buf -> tdata: buf -> wdata;
+
+	const size_t cells = buf -> width * buf -> height;
+	uint32_t most = 0;
+
+	if(buf -> truecolour)
+		for(size_t i = 0; i < cells; i++)
+			if(counts[i] > most) most = counts[i];
+
+	for(size_t i = 0; i < cells; i++) {
+		uint32_t count = counts[i];
+		char *cell = buf -> data + i * buf -> chwidth;
+
+		if(buf -> colour && buf -> truecolour) {
+			LSCc_rgb(cell, count * 3 < most * 2? 0xffffff: 0,
+				smooth(count, most));
+		}
+
+		else if(buf -> colour) {
+			uint8_t bg = ramp[count < 9? count: 9];
+			LSCc_col(cell, count < 6? 231: 16, bg);
+		}
+
+		if(buf -> glyph == 1)
+			cell[buf -> chwidth - 1] = glyphs[count < 10? count: 10];
+	}
+
+	LSCb_touch(buf, 0, buf -> height);
+}
+
+int LSCb_heatdump(LSCb_t *buf, FILE *file, bool tests) {
+	if(!buf -> wdata) return LSCE_NOOP;
+	const uint32_t *counts = tests? buf -> tdata: buf -> wdata;
+
+	uint32_t max = 1;
+	for(size_t i = 0; i < buf -> width * buf -> height; i++)
+		if(counts[i] > max) max = counts[i];
+
+	int ret = fprintf(file, "P2\n%zu %zu\n%" PRIu32 "\n",
+		buf -> width, buf -> height, max);
+
+	for(size_t y = 0; ret >= 0 && y < buf -> height; y++) {
+		for(size_t x = 0; ret >= 0 && x < buf -> width; x++) {
+			ret = fprintf(file, x? " %" PRIu32: "%" PRIu32,
+				counts[x + y * buf -> width]);
+		}
+
+		if(ret >= 0) ret = fputc('\n', file);
+	}
+
+	if(ret < 0) {
+		if(LSCe_auto) perror("stdio");
+		LSC_errno = LSC_PRINTF_ERR;
+		return LSCE_NOOP;
+	}
+
+	return LSCE_OK;
+}
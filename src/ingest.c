@@ -0,0 +1,621 @@
+/* libScricon: The Simple Graphical Console Library
+ * Copyright (C) 2021-2022 Jyothiraditya Nellakra
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#include <ctype.h>
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <threads.h>
+
+#include <unistd.h>
+
+#include <LSC_buffer.h>
+#include <LSC_colour.h>
+#include <LSC_error.h>
+#include <LSC_ingest.h>
+#include <LSC_quantize.h>
+#include <LSC_trace.h>
+
+static const char *ramp = " .:-=+*#%@";
+
+void LSCi_init(LSCi_t *in, int fd, int format) {
+	in -> fd = fd;
+	in -> format = format;
+	in -> eof = false;
+
+	in -> width = 0;
+	in -> height = 0;
+	in -> chroma = -1;
+
+	in -> ramp = ramp;
+	in -> fill = false;
+	in -> dither = false;
+
+	in -> head = 0;
+	in -> tail = 0;
+
+	in -> size = 0;
+	in -> sums = NULL;
+	in -> row = NULL;
+}
+
+void LSCi_free(LSCi_t *in) {
+	free(in -> sums);
+	in -> sums = NULL;
+
+	free(in -> row);
+	in -> row = NULL;
+	in -> size = 0;
+}
+
+void LSCi_frameinit(LSCi_frame_t *frame) {
+	frame -> width = 0;
+	frame -> height = 0;
+	frame -> channels = 0;
+
+	frame -> size = 0;
+	frame -> data = NULL;
+}
+
+void LSCi_framefree(LSCi_frame_t *frame) {
+	free(frame -> data);
+	frame -> data = NULL;
+	frame -> size = 0;
+}
+
+static int fail(int err, const char *what) {
+	if(what && LSCe_auto) perror(what);
+	LSC_errno = err;
+	return LSCE_NOOP;
+}
+
+/* Both of these set eof when the data runs out, so that the caller can tell
+ * the end of a stream from an error. A frame cut short counts as the end. */
+
+static int next(LSCi_t *in) {
+	if(in -> head == in -> tail) {
+		ssize_t ret;
+		do ret = read(in -> fd, in -> buffer, sizeof(in -> buffer));
+		while(ret == -1 && errno == EINTR);
+
+		if(ret == -1) {
+			fail(LSC_READ_ERR, "unistd");
+			return -1;
+		}
+
+		if(ret == 0) {
+			in -> eof = true;
+			return -1;
+		}
+
+		in -> head = 0;
+		in -> tail = ret;
+	}
+
+	return in -> buffer[in -> head++];
+}
+
+static int take(LSCi_t *in, uint8_t *data, size_t len) {
+	size_t have = in -> tail - in -> head;
+	if(have > len) have = len;
+
+	memcpy(data, in -> buffer + in -> head, have);
+	in -> head += have;
+
+	while(have < len) {
+		ssize_t ret = read(in -> fd, data + have, len - have);
+		if(ret == -1 && errno == EINTR) continue;
+
+		if(ret == -1) return fail(LSC_READ_ERR, "unistd");
+		if(ret == 0) {
+			in -> eof = true;
+			return LSCE_NOOP;
+		}
+
+		have += ret;
+	}
+
+	return LSCE_OK;
+}
+
+static int shape(LSCi_frame_t *frame, size_t width, size_t height,
+	size_t channels, size_t size)
+{
+	if(size > frame -> size) {
+		uint8_t *data = realloc(frame -> data, size);
+		if(!data) {
+			if(LSCe_auto) perror("stdlib");
+			LSC_errno = LSC_MALLOC_ERR;
+			return LSCE_NOOP;
+		}
+
+		frame -> data = data;
+		frame -> size = size;
+	}
+
+	frame -> width = width;
+	frame -> height = height;
+	frame -> channels = channels;
+	return LSCE_OK;
+}
+
+static int field(LSCi_t *in, size_t *value) {
+	int c = next(in);
+
+	while(c == '#' || isspace(c)) {
+		if(c == '#') while(c != -1 && c != '\n') c = next(in);
+		else c = next(in);
+	}
+
+	if(c == -1) return LSCE_NOOP;
+	if(!isdigit(c)) return fail(LSC_FORMAT_ERR, NULL);
+
+	for(*value = 0; isdigit(c); c = next(in)) {
+		*value = *value * 10 + c - '0';
+		if(*value > 65535) return fail(LSC_FORMAT_ERR, NULL);
+	}
+
+	return c == -1? LSCE_NOOP: LSCE_OK;
+}
+
+static int ppm(LSCi_t *in, LSCi_frame_t *frame) {
+	int c = next(in);
+	while(isspace(c)) c = next(in);
+	if(c == -1) return LSCE_NOOP;
+
+	const int kind = next(in);
+	if(kind == -1) return LSCE_NOOP;
+	if(c != 'P' || (kind != '5' && kind != '6'))
+		return fail(LSC_FORMAT_ERR, NULL);
+
+	size_t width, height, depth;
+	if(field(in, &width) != LSCE_OK || field(in, &height) != LSCE_OK
+		|| field(in, &depth) != LSCE_OK) { return LSCE_NOOP; }
+
+	if(!width || !height || !depth || depth > 255)
+		return fail(LSC_FORMAT_ERR, NULL);
+
+	const size_t channels = kind == '6'? 3: 1;
+	const size_t len = width * height * channels;
+
+	if(shape(frame, width, height, channels, len) != LSCE_OK)
+		return LSCE_NOOP;
+
+	if(take(in, frame -> data, len) != LSCE_OK) return LSCE_NOOP;
+
+	if(depth != 255) for(size_t i = 0; i < len; i++)
+		frame -> data[i] = frame -> data[i] * 255 / depth;
+
+	return LSCE_OK;
+}
+
+static int line(LSCi_t *in, char *data, size_t size) {
+	size_t len = 0;
+
+	for(int c = next(in); c != '\n'; c = next(in)) {
+		if(c == -1) return LSCE_NOOP;
+		if(len + 1 == size) return fail(LSC_FORMAT_ERR, NULL);
+		data[len++] = c;
+	}
+
+	data[len] = 0;
+	return LSCE_OK;
+}
+
+/* Only 8-bit streams are taken. Chroma siting is ignored, and the chroma
+ * planes are simply sampled at half resolution where they have it. */
+
+static int chroma(const char *name) {
+	if(!strcmp(name, "mono")) return 0;
+	if(!strcmp(name, "444")) return 444;
+	if(!strcmp(name, "422")) return 422;
+
+	if(!strcmp(name, "420") || !strcmp(name, "420jpeg")
+		|| !strcmp(name, "420paldv") || !strcmp(name, "420mpeg2"))
+	{ return 420; }
+
+	return -1;
+}
+
+static int header(LSCi_t *in) {
+	char data[256];
+	if(line(in, data, sizeof(data)) != LSCE_OK) return LSCE_NOOP;
+	if(strncmp(data, "YUV4MPEG2", 9)) return fail(LSC_FORMAT_ERR, NULL);
+
+	in -> chroma = 420;
+	in -> width = in -> height = 0;
+	char *save;
+
+	for(char *token = strtok_r(data + 9, " ", &save); token;
+		token = strtok_r(NULL, " ", &save))
+	{
+		if(*token == 'W')
+			in -> width = strtoul(token + 1, NULL, 10);
+
+		else if(*token == 'H')
+			in -> height = strtoul(token + 1, NULL, 10);
+
+		else if(*token == 'C') in -> chroma = chroma(token + 1);
+	}
+
+	if(in -> chroma < 0 || !in -> width || !in -> height
+		|| in -> width > 65535 || in -> height > 65535)
+	{ return fail(LSC_FORMAT_ERR, NULL); }
+
+	return LSCE_OK;
+}
+
+static uint8_t clamp(int v) {
+	return v < 0? 0: v > 255? 255: v;
+}
+
+static void convert(LSCi_t *in, LSCi_frame_t *frame, const uint8_t *yuv) {
+	const size_t width = in -> width, height = in -> height;
+	const int xs = in -> chroma != 444, ys = in -> chroma == 420;
+	const size_t cw = (width + xs) >> xs, ch = (height + ys) >> ys;
+
+	const uint8_t *u = yuv + width * height, *v = u + cw * ch;
+	uint8_t *rgb = frame -> data;
+
+	for(size_t y = 0; y < height; y++) {
+		for(size_t x = 0; x < width; x++) {
+			const size_t i = (x >> xs) + (y >> ys) * cw;
+			const int c = 298 * (yuv[x + y * width] - 16) + 128;
+			const int d = u[i] - 128, e = v[i] - 128;
+
+			*rgb++ = clamp((c + 409 * e) >> 8);
+			*rgb++ = clamp((c - 100 * d - 208 * e) >> 8);
+			*rgb++ = clamp((c + 516 * d) >> 8);
+		}
+	}
+}
+
+static int y4m(LSCi_t *in, LSCi_frame_t *frame) {
+	if(in -> chroma < 0 && header(in) != LSCE_OK) return LSCE_NOOP;
+
+	char data[256];
+	if(line(in, data, sizeof(data)) != LSCE_OK) return LSCE_NOOP;
+	if(strncmp(data, "FRAME", 5)) return fail(LSC_FORMAT_ERR, NULL);
+
+	const size_t width = in -> width, height = in -> height;
+	const size_t luma = width * height;
+
+	if(!in -> chroma) {
+		if(shape(frame, width, height, 1, luma) != LSCE_OK)
+			return LSCE_NOOP;
+
+		return take(in, frame -> data, luma);
+	}
+
+	const int xs = in -> chroma != 444, ys = in -> chroma == 420;
+	const size_t len = luma + 2 * ((width + xs) >> xs)
+		* ((height + ys) >> ys);
+
+	if(shape(frame, width, height, 3, 3 * luma + len) != LSCE_OK)
+		return LSCE_NOOP;
+
+	if(take(in, frame -> data + 3 * luma, len) != LSCE_OK)
+		return LSCE_NOOP;
+
+	convert(in, frame, frame -> data + 3 * luma);
+	return LSCE_OK;
+}
+
+int LSCi_read(LSCi_t *in, LSCi_frame_t *frame) {
+	LSCX_BEGIN("decode");
+	int ret;
+
+	if(in -> format == LSCI_PPM) ret = ppm(in, frame);
+	else if(in -> format == LSCI_Y4M) ret = y4m(in, frame);
+
+	else {
+		const size_t channels = in -> format == LSCI_RGB? 3: 1;
+		const size_t len = in -> width * in -> height * channels;
+
+		ret = len? shape(frame, in -> width, in -> height, channels, len):
+			fail(LSC_FORMAT_ERR, NULL);
+
+		if(ret == LSCE_OK) ret = take(in, frame -> data, len);
+	}
+
+	LSCX_END("decode");
+	return ret;
+}
+
+static int reserve(LSCi_t *in, size_t width) {
+	if(width <= in -> size) return LSCE_OK;
+
+	uint32_t *sums = realloc(in -> sums,
+		sizeof(uint32_t) * (4 * width + 1));
+
+	if(sums) in -> sums = sums;
+
+	uint8_t *row = sums? realloc(in -> row, 4 * width): NULL;
+	if(!row) {
+		if(LSCe_auto) perror("stdlib");
+		LSC_errno = LSC_MALLOC_ERR;
+		return LSCE_NOOP;
+	}
+
+	in -> row = row;
+	in -> size = width;
+	return LSCE_OK;
+}
+
+/* Each cell takes the average of the block of pixels that falls inside it,
+ * and gets its glyph from its brightness. On colour buffers it is coloured
+ * in as well, either behind the glyph or, with fill set, as a solid block. */
+
+static void map(LSCi_t *in, LSCb_t *buf, size_t y, size_t len) {
+	const uint8_t *rgb = in -> row;
+	uint8_t *index = in -> row + 3 * buf -> width;
+
+	if(buf -> colour && !buf -> truecolour) {
+		if(in -> dither) LSCq_dither(index, rgb, buf -> width, 0, y);
+		else LSCq_row(index, rgb, buf -> width);
+	}
+
+	for(size_t x = 0; x < buf -> width; x++, rgb += 3) {
+		const unsigned luma = (2 * rgb[0] + 5 * rgb[1] + rgb[2]) >> 3;
+		const char chr = in -> fill || !len? ' ':
+			in -> ramp[luma * (len - 1) / 255];
+
+		const uint32_t col = LSCC_RGB(rgb[0], rgb[1], rgb[2]);
+
+		const uint8_t fg = buf -> truecolour? 0: index[x];
+		const uint8_t bg = in -> fill? fg: 16;
+
+		if(!buf -> colour) LSCb_set(buf, x, y, chr);
+		else if(!buf -> truecolour) LSCb_setall(buf, x, y, chr, fg, bg);
+		else LSCb_setallrgb(buf, x, y, chr, col, in -> fill? col: 0);
+	}
+}
+
+int LSCi_draw(LSCi_t *in, const LSCi_frame_t *frame, LSCb_t *buf) {
+	const size_t width = buf -> width, height = buf -> height;
+	if(reserve(in, width) != LSCE_OK) return LSCE_NOOP;
+
+	LSCX_BEGIN("scale");
+
+	const size_t fw = frame -> width, fh = frame -> height;
+	const size_t channels = frame -> channels;
+	const size_t len = in -> ramp? strlen(in -> ramp): 0;
+
+	uint32_t *sums = in -> sums, *left = sums + 3 * width;
+	for(size_t x = 0; x <= width; x++) left[x] = x * fw / width;
+
+	for(size_t y = 0; y < height; y++) {
+		const size_t top = y * fh / height;
+		size_t bottom = (y + 1) * fh / height;
+		if(bottom <= top) bottom = top + 1;
+
+		memset(sums, 0, sizeof(uint32_t) * 3 * width);
+
+		for(size_t sy = top; sy < bottom; sy++) {
+			const uint8_t *src = frame -> data + sy * fw * channels;
+
+			for(size_t x = 0; x < width; x++) {
+				const size_t to = left[x + 1] > left[x]?
+					left[x + 1]: left[x] + 1;
+
+				for(size_t sx = left[x]; sx < to; sx++) {
+					const uint8_t *px = src + sx * channels;
+					sums[3 * x] += px[0];
+
+					if(channels == 3) {
+						sums[3 * x + 1] += px[1];
+						sums[3 * x + 2] += px[2];
+					}
+				}
+			}
+		}
+
+		for(size_t x = 0; x < width; x++) {
+			const size_t cols = left[x + 1] > left[x]?
+				left[x + 1] - left[x]: 1;
+
+			const uint32_t count = cols * (bottom - top);
+			uint8_t *rgb = in -> row + 3 * x;
+
+			rgb[0] = sums[3 * x] / count;
+			rgb[1] = channels == 3? sums[3 * x + 1] / count: rgb[0];
+			rgb[2] = channels == 3? sums[3 * x + 2] / count: rgb[0];
+		}
+
+		map(in, buf, y, len);
+	}
+
+	LSCX_END("scale");
+	return LSCE_OK;
+}
+
+/* The reader and the mapper run a few frames ahead of the caller, passing
+ * frames along a ring of jobs. Each counter only ever moves forward, and a
+ * job is only touched by the stage whose counter points at it, so the lock
+ * just guards the counters themselves. */
+
+static int reader(void *arg) {
+	LSCi_stream_t *stream = arg;
+	mtx_lock(&stream -> lock);
+
+	while(!stream -> stop) {
+		if(stream -> read - stream -> shown == LSCI_DEPTH) {
+			cnd_wait(&stream -> cond, &stream -> lock);
+			continue;
+		}
+
+		LSCi_job_t *job = &stream -> jobs[stream -> read % LSCI_DEPTH];
+		mtx_unlock(&stream -> lock);
+
+		int ret = LSCi_read(stream -> in, &job -> frame);
+		mtx_lock(&stream -> lock);
+
+		if(ret != LSCE_OK) {
+			if(!stream -> in -> eof) stream -> error = LSC_errno;
+			stream -> ended = true;
+			break;
+		}
+
+		stream -> read++;
+		cnd_broadcast(&stream -> cond);
+	}
+
+	cnd_broadcast(&stream -> cond);
+	mtx_unlock(&stream -> lock);
+	return 0;
+}
+
+static int mapper(void *arg) {
+	LSCi_stream_t *stream = arg;
+	mtx_lock(&stream -> lock);
+
+	while(!stream -> stop && !stream -> error) {
+		if(stream -> mapped == stream -> read) {
+			if(stream -> ended) break;
+
+			cnd_wait(&stream -> cond, &stream -> lock);
+			continue;
+		}
+
+		const size_t i = stream -> mapped % LSCI_DEPTH;
+		LSCi_job_t *job = &stream -> jobs[i];
+		mtx_unlock(&stream -> lock);
+
+		int ret = LSCi_draw(stream -> in, &job -> frame, &job -> buf);
+		mtx_lock(&stream -> lock);
+
+		if(ret != LSCE_OK) {
+			stream -> error = LSC_errno;
+			break;
+		}
+
+		stream -> mapped++;
+		cnd_broadcast(&stream -> cond);
+	}
+
+	cnd_broadcast(&stream -> cond);
+	mtx_unlock(&stream -> lock);
+	return 0;
+}
+
+static void release(LSCi_stream_t *stream) {
+	for(size_t i = 0; i < LSCI_DEPTH; i++) {
+		LSCi_framefree(&stream -> jobs[i].frame);
+		LSCb_free(&stream -> jobs[i].buf);
+	}
+
+	cnd_destroy(&stream -> cond);
+	mtx_destroy(&stream -> lock);
+}
+
+int LSCi_start(LSCi_stream_t *stream, LSCi_t *in, const LSCb_t *shape) {
+	stream -> in = in;
+	stream -> read = stream -> mapped = stream -> shown = 0;
+	stream -> ended = stream -> stop = false;
+	stream -> error = 0;
+
+	if(mtx_init(&stream -> lock, mtx_plain) != thrd_success) {
+		LSC_errno = LSC_MTX_INIT_ERR;
+		return LSCE_NOOP;
+	}
+
+	if(cnd_init(&stream -> cond) != thrd_success) {
+		mtx_destroy(&stream -> lock);
+		LSC_errno = LSC_MTX_INIT_ERR;
+		return LSCE_NOOP;
+	}
+
+	int ret = LSCE_OK;
+	for(size_t i = 0; i < LSCI_DEPTH; i++) {
+		LSCi_job_t *job = &stream -> jobs[i];
+		LSCi_frameinit(&job -> frame);
+		LSCb_init(&job -> buf);
+
+		job -> buf.colour = shape -> colour;
+		job -> buf.truecolour = shape -> truecolour;
+		job -> buf.width = shape -> width;
+		job -> buf.height = shape -> height;
+		job -> buf.cchs = shape -> cchs;
+		job -> buf.cch = shape -> cch;
+
+		if(ret == LSCE_OK) ret = LSCb_alloc(&job -> buf);
+	}
+
+	if(ret != LSCE_OK) {
+		release(stream);
+		return LSCE_NOOP;
+	}
+
+	if(thrd_create(&stream -> reader, reader, stream) != thrd_success) {
+		release(stream);
+		LSC_errno = LSC_THREAD_CREATE_ERR;
+		return LSCE_NOOP;
+	}
+
+	if(thrd_create(&stream -> mapper, mapper, stream) != thrd_success) {
+		mtx_lock(&stream -> lock);
+		stream -> stop = true;
+		cnd_broadcast(&stream -> cond);
+		mtx_unlock(&stream -> lock);
+
+		thrd_join(stream -> reader, NULL);
+		release(stream);
+
+		LSC_errno = LSC_THREAD_CREATE_ERR;
+		return LSCE_NOOP;
+	}
+
+	return LSCE_OK;
+}
+
+LSCb_t *LSCi_next(LSCi_stream_t *stream) {
+	mtx_lock(&stream -> lock);
+
+	while(stream -> shown == stream -> mapped && !stream -> error
+		&& !(stream -> ended && stream -> mapped == stream -> read))
+	{ cnd_wait(&stream -> cond, &stream -> lock); }
+
+	LSCb_t *buf = NULL;
+	if(stream -> shown < stream -> mapped)
+		buf = &stream -> jobs[stream -> shown % LSCI_DEPTH].buf;
+
+	else if(stream -> error) LSC_errno = stream -> error;
+
+	mtx_unlock(&stream -> lock);
+	return buf;
+}
+
+void LSCi_done(LSCi_stream_t *stream) {
+	mtx_lock(&stream -> lock);
+	stream -> shown++;
+	cnd_broadcast(&stream -> cond);
+	mtx_unlock(&stream -> lock);
+}
+
+void LSCi_stop(LSCi_stream_t *stream) {
+	mtx_lock(&stream -> lock);
+	stream -> stop = true;
+	cnd_broadcast(&stream -> cond);
+	mtx_unlock(&stream -> lock);
+
+	thrd_join(stream -> reader, NULL);
+	thrd_join(stream -> mapper, NULL);
+	release(stream);
+}
@@ -17,10 +17,11 @@
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
-#include <stdio.h>
 
 #include <LSC_buffer.h>
+#include <LSC_colour.h>
 #include <LSC_lines.h>
+#include <LSC_stats.h>
 
 typedef struct {
 	void (*function)(LSCb_t *buf, size_t x, size_t y, const char *data);
@@ -169,11 +170,12 @@ static void algorithm(call_t call, intmax_t x1, intmax_t y1,
 
 void LSCl_draw(LSCb_t *buf, size_t x1, size_t y1, size_t x2, size_t y2) {
 	bool validate = buf -> validate == LSCB_VALIDATE_CHAR;
+	LSCS_ADD(primitives, 1);
 
 	if(buf -> validate == LSCB_VALIDATE_SHAPE) {
 		if(x1 >= buf -> width || x2 >= buf -> width
 			|| y1 >= buf -> height || y2 >= buf -> height)
-		{ return; }
+		{ LSCS_ADD(clipped, 1); return; }
 	}
 
 	call_t call = {validate? LSCb_setsv: LSCb_sets, buf, " "};
@@ -184,17 +186,18 @@ void LSCl_drawcol(LSCb_t *buf, size_t x1, size_t y1, size_t x2, size_t y2,
 	uint8_t fg, uint8_t bg)
 {
 	bool validate = buf -> validate == LSCB_VALIDATE_CHAR;
+	LSCS_ADD(primitives, 1);
 
 	if(buf -> validate == LSCB_VALIDATE_SHAPE) {
 		if(x1 >= buf -> width || x2 >= buf -> width
 			|| y1 >= buf -> height || y2 >= buf -> height)
-		{ return; }
+		{ LSCS_ADD(clipped, 1); return; }
 	}
 
 	char data[23];
 	call_t call = {validate? LSCb_setcolsv: LSCb_setcols, buf, " "};
 
-	sprintf(data, "\033[48;5;%03um\033[38;5;%03um", bg, fg);
+	LSCc_col(data, fg, bg);
 	call.data = data;
 
 	algorithm(call, x1, y1, x2, y2);
@@ -204,17 +207,18 @@ void LSCl_drawfg(LSCb_t *buf, size_t x1, size_t y1, size_t x2, size_t y2,
 	uint8_t fg)
 {
 	bool validate = buf -> validate == LSCB_VALIDATE_CHAR;
+	LSCS_ADD(primitives, 1);
 
 	if(buf -> validate == LSCB_VALIDATE_SHAPE) {
 		if(x1 >= buf -> width || x2 >= buf -> width
 			|| y1 >= buf -> height || y2 >= buf -> height)
-		{ return; }
+		{ LSCS_ADD(clipped, 1); return; }
 	}
 
-	char data[12];
+	char data[11];
 	call_t call = {validate? LSCb_setfgsv: LSCb_setfgs, buf, " "};
 
-	sprintf(data, "\033[38;5;%03um", fg);
+	LSCc_fg(data, fg);
 	call.data = data;
 
 	algorithm(call, x1, y1, x2, y2);
@@ -224,17 +228,18 @@ void LSCl_drawbg(LSCb_t *buf, size_t x1, size_t y1, size_t x2, size_t y2,
 	uint8_t bg)
 {
 	bool validate = buf -> validate == LSCB_VALIDATE_CHAR;
+	LSCS_ADD(primitives, 1);
 
 	if(buf -> validate == LSCB_VALIDATE_SHAPE) {
 		if(x1 >= buf -> width || x2 >= buf -> width
 			|| y1 >= buf -> height || y2 >= buf -> height)
-		{ return; }
+		{ LSCS_ADD(clipped, 1); return; }
 	}
 
-	char data[12];
+	char data[11];
 	call_t call = {validate? LSCb_setbgsv: LSCb_setbgs, buf, " "};
 
-	sprintf(data, "\033[48;5;%03um", bg);
+	LSCc_bg(data, bg);
 	call.data = data;
 
 	algorithm(call, x1, y1, x2, y2);
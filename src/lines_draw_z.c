@@ -17,10 +17,11 @@
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
-#include <stdio.h>
 
 #include <LSC_buffer.h>
+#include <LSC_colour.h>
 #include <LSC_lines.h>
+#include <LSC_stats.h>
 
 typedef struct {
 	void (*function)(LSCb_t *buf, size_t x, size_t y, double z,
@@ -207,11 +208,12 @@ void LSCl_drawz(LSCb_t *buf, size_t x1, size_t y1, double z1,
 	size_t x2, size_t y2, double z2)
 {
 	bool validate = buf -> validate == LSCB_VALIDATE_CHAR;
+	LSCS_ADD(primitives, 1);
 
 	if(buf -> validate == LSCB_VALIDATE_SHAPE) {
 		if(x1 >= buf -> width || x2 >= buf -> width
 			|| y1 >= buf -> height || y2 >= buf -> height)
-		{ return; }
+		{ LSCS_ADD(clipped, 1); return; }
 	}
 
 	call_t call = {validate? LSCb_setszv: LSCb_setsz, buf, " "};
@@ -222,18 +224,19 @@ void LSCl_drawcolz(LSCb_t *buf, size_t x1, size_t y1, double z1,
 	size_t x2, size_t y2, double z2, uint8_t fg, uint8_t bg)
 {
 	bool validate = buf -> validate == LSCB_VALIDATE_CHAR;
+	LSCS_ADD(primitives, 1);
 
 	if(buf -> validate == LSCB_VALIDATE_SHAPE) {
 		if(x1 >= buf -> width || x2 >= buf -> width
 			|| y1 >= buf -> height || y2 >= buf -> height)
-		{ return; }
+		{ LSCS_ADD(clipped, 1); return; }
 	}
 
 	char data[23];
 	call_t call = {validate? LSCb_setcolszv: LSCb_setcolsz,
 		buf, " "};
 
-	sprintf(data, "\033[48;5;%03um\033[38;5;%03um", bg, fg);
+	LSCc_col(data, fg, bg);
 	call.data = data;
 
 	algorithm(call, x1, y1, z1, x2, y2, z2);
@@ -243,17 +246,18 @@ void LSCl_drawfgz(LSCb_t *buf, size_t x1, size_t y1, double z1,
 	size_t x2, size_t y2, double z2, uint8_t fg)
 {
 	bool validate = buf -> validate == LSCB_VALIDATE_CHAR;
+	LSCS_ADD(primitives, 1);
 
 	if(buf -> validate == LSCB_VALIDATE_SHAPE) {
 		if(x1 >= buf -> width || x2 >= buf -> width
 			|| y1 >= buf -> height || y2 >= buf -> height)
-		{ return; }
+		{ LSCS_ADD(clipped, 1); return; }
 	}
 
-	char data[12];
+	char data[11];
 	call_t call = {validate? LSCb_setfgszv: LSCb_setfgsz, buf, " "};
 
-	sprintf(data, "\033[38;5;%03um", fg);
+	LSCc_fg(data, fg);
 	call.data = data;
 
 	algorithm(call, x1, y1, z1, x2, y2, z2);
@@ -263,17 +267,18 @@ void LSCl_drawbgz(LSCb_t *buf, size_t x1, size_t y1, double z1,
 	size_t x2, size_t y2, double z2, uint8_t bg)
 {
 	bool validate = buf -> validate == LSCB_VALIDATE_CHAR;
+	LSCS_ADD(primitives, 1);
 
 	if(buf -> validate == LSCB_VALIDATE_SHAPE) {
 		if(x1 >= buf -> width || x2 >= buf -> width
 			|| y1 >= buf -> height || y2 >= buf -> height)
-		{ return; }
+		{ LSCS_ADD(clipped, 1); return; }
 	}
 
-	char data[12];
+	char data[11];
 	call_t call = {validate? LSCb_setbgszv: LSCb_setbgsz, buf, " "};
 
-	sprintf(data, "\033[48;5;%03um", bg);
+	LSCc_bg(data, bg);
 	call.data = data;
 
 	algorithm(call, x1, y1, z1, x2, y2, z2);
@@ -17,10 +17,12 @@
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
-#include <stdio.h>
 
+#include <LSC_braille.h>
 #include <LSC_buffer.h>
+#include <LSC_colour.h>
 #include <LSC_lines.h>
+#include <LSC_stats.h>
 
 typedef struct {
 	void (*function)(LSCb_t *buf, size_t x, size_t y, const char *data);
@@ -140,11 +142,12 @@ void LSCl_set(LSCb_t *buf, size_t x1, size_t y1, size_t x2, size_t y2,
 	char chr)
 {
 	bool validate = buf -> validate == LSCB_VALIDATE_CHAR;
+	LSCS_ADD(primitives, 1);
 
 	if(buf -> validate == LSCB_VALIDATE_SHAPE) {
 		if(x1 >= buf -> width || x2 >= buf -> width
 			|| y1 >= buf -> height || y2 >= buf -> height)
-		{ return; }
+		{ LSCS_ADD(clipped, 1); return; }
 	}
 
 	char data[2] = {chr, ' '};
@@ -158,17 +161,18 @@ void LSCl_setcol(LSCb_t *buf, size_t x1, size_t y1, size_t x2, size_t y2,
 	uint8_t fg, uint8_t bg)
 {
 	bool validate = buf -> validate == LSCB_VALIDATE_CHAR;
+	LSCS_ADD(primitives, 1);
 
 	if(buf -> validate == LSCB_VALIDATE_SHAPE) {
 		if(x1 >= buf -> width || x2 >= buf -> width
 			|| y1 >= buf -> height || y2 >= buf -> height)
-		{ return; }
+		{ LSCS_ADD(clipped, 1); return; }
 	}
 
 	char data[23];
 	call_t call = {validate? LSCb_setcolsv: LSCb_setcols, buf, " "};
 
-	sprintf(data, "\033[48;5;%03um\033[38;5;%03um", bg, fg);
+	LSCc_col(data, fg, bg);
 	call.data = data;
 
 	algorithm(call, x1, y1, x2, y2);
@@ -178,17 +182,18 @@ void LSCl_setfg(LSCb_t *buf, size_t x1, size_t y1, size_t x2, size_t y2,
 	uint8_t fg)
 {
 	bool validate = buf -> validate == LSCB_VALIDATE_CHAR;
+	LSCS_ADD(primitives, 1);
 
 	if(buf -> validate == LSCB_VALIDATE_SHAPE) {
 		if(x1 >= buf -> width || x2 >= buf -> width
 			|| y1 >= buf -> height || y2 >= buf -> height)
-		{ return; }
+		{ LSCS_ADD(clipped, 1); return; }
 	}
 
-	char data[12];
+	char data[11];
 	call_t call = {validate? LSCb_setfgsv: LSCb_setfgs, buf, " "};
 
-	sprintf(data, "\033[38;5;%03um", fg);
+	LSCc_fg(data, fg);
 	call.data = data;
 
 	algorithm(call, x1, y1, x2, y2);
@@ -198,17 +203,18 @@ void LSCl_setbg(LSCb_t *buf, size_t x1, size_t y1, size_t x2, size_t y2,
 	uint8_t bg)
 {
 	bool validate = buf -> validate == LSCB_VALIDATE_CHAR;
+	LSCS_ADD(primitives, 1);
 
 	if(buf -> validate == LSCB_VALIDATE_SHAPE) {
 		if(x1 >= buf -> width || x2 >= buf -> width
 			|| y1 >= buf -> height || y2 >= buf -> height)
-		{ return; }
+		{ LSCS_ADD(clipped, 1); return; }
 	}
 
-	char data[12];
+	char data[11];
 	call_t call = {validate? LSCb_setbgsv: LSCb_setbgs, buf, " "};
 
-	sprintf(data, "\033[48;5;%03um", bg);
+	LSCc_bg(data, bg);
 	call.data = data;
 
 	algorithm(call, x1, y1, x2, y2);
@@ -218,18 +224,48 @@ void LSCl_setall(LSCb_t *buf, size_t x1, size_t y1, size_t x2, size_t y2,
 	char chr, uint8_t fg, uint8_t bg)
 {
 	bool validate = buf -> validate == LSCB_VALIDATE_CHAR;
+	LSCS_ADD(primitives, 1);
 
 	if(buf -> validate == LSCB_VALIDATE_SHAPE) {
 		if(x1 >= buf -> width || x2 >= buf -> width
 			|| y1 >= buf -> height || y2 >= buf -> height)
-		{ return; }
+		{ LSCS_ADD(clipped, 1); return; }
 	}
 
-	char data[24];
+	char data[23];
 	call_t call = {validate? LSCb_setallsv: LSCb_setalls, buf, " "};
 
-	sprintf(data, "\033[48;5;%03um\033[38;5;%03um%c", bg, fg, chr);
+	LSCc_col(data, fg, bg);
+	data[22] = chr;
 	call.data = data;
 
 	algorithm(call, x1, y1, x2, y2);
-}
\ No newline at end of file
+}
+
+static void dot(LSCb_t *buf, size_t x, size_t y, const char *data) {
+	(void) data; LSCd_set(buf, x, y);
+}
+
+static void dotv(LSCb_t *buf, size_t x, size_t y, const char *data) {
+	(void) data;
+	if(x < 2 * buf -> width && y < 4 * buf -> height) LSCd_set(buf, x, y);
+}
+
+/* Coordinates are in dots, two across and four down per cell of the mask
+ * buffer, and every dot is ORed into its cell. */
+
+void LSCl_dots(LSCb_t *dots, size_t x1, size_t y1, size_t x2, size_t y2) {
+	bool validate = dots -> validate == LSCB_VALIDATE_CHAR;
+	LSCS_ADD(primitives, 1);
+
+	if(dots -> validate == LSCB_VALIDATE_SHAPE) {
+		const size_t width = dots -> width * 2;
+		const size_t height = dots -> height * 4;
+
+		if(x1 >= width || x2 >= width || y1 >= height || y2 >= height)
+		{ LSCS_ADD(clipped, 1); return; }
+	}
+
+	call_t call = {validate? dotv: dot, dots, NULL};
+	algorithm(call, x1, y1, x2, y2);
+}
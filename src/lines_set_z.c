@@ -17,10 +17,11 @@
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
-#include <stdio.h>
 
 #include <LSC_buffer.h>
+#include <LSC_colour.h>
 #include <LSC_lines.h>
+#include <LSC_stats.h>
 
 typedef struct {
 	void (*function)(LSCb_t *buf, size_t x, size_t y, double z,
@@ -168,11 +169,12 @@ void LSCl_setz(LSCb_t *buf, size_t x1, size_t y1, double z1,
 	size_t x2, size_t y2, double z2, char chr)
 {
 	bool validate = buf -> validate == LSCB_VALIDATE_CHAR;
+	LSCS_ADD(primitives, 1);
 
 	if(buf -> validate == LSCB_VALIDATE_SHAPE) {
 		if(x1 >= buf -> width || x2 >= buf -> width
 			|| y1 >= buf -> height || y2 >= buf -> height)
-		{ return; }
+		{ LSCS_ADD(clipped, 1); return; }
 	}
 
 	char data[2] = {chr, ' '};
@@ -186,18 +188,19 @@ void LSCl_setcolz(LSCb_t *buf, size_t x1, size_t y1, double z1,
 	size_t x2, size_t y2, double z2, uint8_t fg, uint8_t bg)
 {
 	bool validate = buf -> validate == LSCB_VALIDATE_CHAR;
+	LSCS_ADD(primitives, 1);
 
 	if(buf -> validate == LSCB_VALIDATE_SHAPE) {
 		if(x1 >= buf -> width || x2 >= buf -> width
 			|| y1 >= buf -> height || y2 >= buf -> height)
-		{ return; }
+		{ LSCS_ADD(clipped, 1); return; }
 	}
 
 	char data[23];
 	call_t call = {validate? LSCb_setcolszv: LSCb_setcolsz,
 		buf, " "};
 
-	sprintf(data, "\033[48;5;%03um\033[38;5;%03um", bg, fg);
+	LSCc_col(data, fg, bg);
 	call.data = data;
 
 	algorithm(call, x1, y1, z1, x2, y2, z2);
@@ -207,17 +210,18 @@ void LSCl_setfgz(LSCb_t *buf, size_t x1, size_t y1, double z1,
 	size_t x2, size_t y2, double z2, uint8_t fg)
 {
 	bool validate = buf -> validate == LSCB_VALIDATE_CHAR;
+	LSCS_ADD(primitives, 1);
 
 	if(buf -> validate == LSCB_VALIDATE_SHAPE) {
 		if(x1 >= buf -> width || x2 >= buf -> width
 			|| y1 >= buf -> height || y2 >= buf -> height)
-		{ return; }
+		{ LSCS_ADD(clipped, 1); return; }
 	}
 
-	char data[12];
+	char data[11];
 	call_t call = {validate? LSCb_setfgszv: LSCb_setfgsz, buf, " "};
 
-	sprintf(data, "\033[38;5;%03um", fg);
+	LSCc_fg(data, fg);
 	call.data = data;
 
 	algorithm(call, x1, y1, z1, x2, y2, z2);
@@ -227,17 +231,18 @@ void LSCl_setbgz(LSCb_t *buf, size_t x1, size_t y1, double z1,
 	size_t x2, size_t y2, double z2, uint8_t bg)
 {
 	bool validate = buf -> validate == LSCB_VALIDATE_CHAR;
+	LSCS_ADD(primitives, 1);
 
 	if(buf -> validate == LSCB_VALIDATE_SHAPE) {
 		if(x1 >= buf -> width || x2 >= buf -> width
 			|| y1 >= buf -> height || y2 >= buf -> height)
-		{ return; }
+		{ LSCS_ADD(clipped, 1); return; }
 	}
 
-	char data[12];
+	char data[11];
 	call_t call = {validate? LSCb_setbgszv: LSCb_setbgsz, buf, " "};
 
-	sprintf(data, "\033[48;5;%03um", bg);
+	LSCc_bg(data, bg);
 	call.data = data;
 
 	algorithm(call, x1, y1, z1, x2, y2, z2);
@@ -247,18 +252,20 @@ void LSCl_setallz(LSCb_t *buf, size_t x1, size_t y1, double z1,
 	size_t x2, size_t y2, double z2, char chr, uint8_t fg, uint8_t bg)
 {
 	bool validate = buf -> validate == LSCB_VALIDATE_CHAR;
+	LSCS_ADD(primitives, 1);
 
 	if(buf -> validate == LSCB_VALIDATE_SHAPE) {
 		if(x1 >= buf -> width || x2 >= buf -> width
 			|| y1 >= buf -> height || y2 >= buf -> height)
-		{ return; }
+		{ LSCS_ADD(clipped, 1); return; }
 	}
 
-	char data[24];
+	char data[23];
 	call_t call = {validate? LSCb_setallszv: LSCb_setallsz,
 		buf, " "};
 
-	sprintf(data, "\033[48;5;%03um\033[38;5;%03um%c", bg, fg, chr);
+	LSCc_col(data, fg, bg);
+	data[22] = chr;
 	call.data = data;
 
 	algorithm(call, x1, y1, z1, x2, y2, z2);
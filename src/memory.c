@@ -0,0 +1,65 @@
+/* libScricon: The Simple Graphical Console Library
+ * Copyright (C) 2021-2022 Jyothiraditya Nellakra
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#include <stddef.h>
+#include <stdlib.h>
+
+#include <sys/mman.h>
+
+#include <LSC_buffer.h>
+
+void *LSCb_malloc(void *ctx, size_t size) {
+	(void) ctx;
+	return aligned_alloc(LSCB_ALIGN, size);
+}
+
+void LSCb_mfree(void *ctx, void *block, size_t size) {
+	(void) ctx; (void) size;
+	free(block);
+}
+
+static size_t pages(size_t size) {
+	return (size + LSCB_HUGE - 1) & ~(size_t) (LSCB_HUGE - 1);
+}
+
+void *LSCb_mmap(void *ctx, size_t size) {
+	if(size < LSCB_HUGE) return LSCb_malloc(ctx, size);
+	size = pages(size);
+
+	void *block = MAP_FAILED;
+	const int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+
+#ifdef MAP_HUGETLB
+	block = mmap(NULL, size, PROT_READ | PROT_WRITE, flags | MAP_HUGETLB,
+		-1, 0);
+#endif
+
+	if(block == MAP_FAILED) {
+		block = mmap(NULL, size, PROT_READ | PROT_WRITE, flags, -1, 0);
+		if(block == MAP_FAILED) return NULL;
+
+#ifdef MADV_HUGEPAGE
+		madvise(block, size, MADV_HUGEPAGE);
+#endif
+	}
+
+	return block;
+}
+
+void LSCb_munmap(void *ctx, void *block, size_t size) {
+	if(size < LSCB_HUGE) LSCb_mfree(ctx, block, size);
+	else munmap(block, pages(size));
+}
@@ -0,0 +1,585 @@
+/* libScricon: The Simple Graphical Console Library
+ * Copyright (C) 2021-2022 Jyothiraditya Nellakra
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include <LSC_buffer.h>
+#include <LSC_error.h>
+#include <LSC_output.h>
+#include <LSC_stats.h>
+#include <LSC_trace.h>
+
+void LSCo_init(LSCo_t *out, int fd) {
+	out -> fd = fd;
+	out -> y = 1;
+	out -> sync = false;
+
+	out -> valid = false;
+	out -> colour = false;
+	out -> chwidth = 0;
+	out -> height = 0;
+	out -> width = 0;
+	out -> shadow = NULL;
+	out -> hashes = NULL;
+
+	out -> escape = 0;
+	out -> glyphs = NULL;
+	out -> styled = false;
+
+	out -> source = NULL;
+	out -> seen = 0;
+
+	out -> cached = 0;
+	out -> cache = NULL;
+
+	out -> sent = 0;
+	out -> used = 0;
+	out -> size = 0;
+	out -> data = NULL;
+
+	out -> pending = NULL;
+}
+
+void LSCo_free(LSCo_t *out) {
+	free(out -> shadow);
+	out -> shadow = NULL;
+
+	free(out -> hashes);
+	out -> hashes = NULL;
+	out -> source = NULL;
+
+	free(out -> data);
+	out -> data = NULL;
+
+	out -> valid = false;
+	out -> sent = 0;
+	out -> used = 0;
+	out -> size = 0;
+
+	out -> pending = NULL;
+}
+
+void LSCo_reset(LSCo_t *out) {
+	out -> valid = false;
+}
+
+static int reserve(LSCo_t *out, size_t len) {
+	if(out -> used + len <= out -> size) return LSCE_OK;
+
+	size_t size = out -> size? out -> size: 4096;
+	while(size < out -> used + len) size *= 2;
+
+	char *data = realloc(out -> data, size);
+	if(!data) {
+		if(LSCe_auto) perror("stdlib");
+		LSC_errno = LSC_MALLOC_ERR;
+		return LSCE_NOOP;
+	}
+
+	out -> data = data;
+	out -> size = size;
+	return LSCE_OK;
+}
+
+static char *number(char *data, size_t n) {
+	char digits[20];
+	size_t len = 0;
+
+	do digits[len++] = '0' + n % 10;
+	while(n /= 10);
+
+	while(len) *data++ = digits[--len];
+	return data;
+}
+
+static char *cup(char *data, size_t y, size_t x) {
+	*data++ = '\033'; *data++ = '[';
+	data = number(data, y);
+	*data++ = ';';
+	data = number(data, x);
+	*data++ = 'H';
+	return data;
+}
+
+static uint64_t rotl(uint64_t n, int bits) {
+	return (n << bits) | (n >> (64 - bits));
+}
+
+uint64_t LSCo_hash(const char *data, size_t len) {
+	const uint64_t p1 = UINT64_C(0x9e3779b185ebca87);
+	const uint64_t p2 = UINT64_C(0xc2b2ae3d27d4eb4f);
+
+	uint64_t hash = UINT64_C(0x27d4eb2f165667c5) + len;
+	uint64_t word;
+
+	for(; len >= 8; data += 8, len -= 8) {
+		memcpy(&word, data, 8);
+		hash ^= rotl(word * p2, 31) * p1;
+		hash = rotl(hash, 27) * p1 + p2;
+	}
+
+	if(len) {
+		word = 0;
+		memcpy(&word, data, len);
+		hash ^= rotl(word * p2, 31) * p1;
+		hash = rotl(hash, 27) * p1 + p2;
+	}
+
+	hash ^= hash >> 33; hash *= p2;
+	hash ^= hash >> 29; hash *= p1;
+	return hash ^ (hash >> 32);
+}
+
+void LSCo_uncache(LSCo_row_t *cache, size_t count) {
+	for(size_t i = 0; i < count; i++) {
+		free(cache[i].data);
+
+		cache[i].valid = false;
+		cache[i].len = 0;
+		cache[i].size = 0;
+		cache[i].data = NULL;
+	}
+}
+
+static void store(LSCo_t *out, LSCo_row_t *entry, uint64_t from, uint64_t to,
+	const char *data, size_t len)
+{
+	entry -> valid = false;
+
+	if(len > entry -> size) {
+		char *copy = realloc(entry -> data, len);
+		if(!copy) return;
+
+		entry -> data = copy;
+		entry -> size = len;
+	}
+
+	memcpy(entry -> data, data, len);
+	entry -> len = len;
+
+	entry -> y = out -> y;
+	entry -> width = out -> width;
+	entry -> from = from;
+	entry -> to = to;
+	entry -> valid = true;
+}
+
+/* Colour cells start with a background and a foreground escape, followed by
+ * the glyph, and since the terminal keeps whichever colours it was sent last,
+ * either escape is left out when it matches the one last sent. */
+
+static size_t escape(LSCb_t *buf) {
+	return !buf -> colour? 0: buf -> truecolour? 19: 11;
+}
+
+static char *emit(LSCo_t *out, char *data, const char *cell, size_t cw,
+	bool room)
+{
+	const size_t half = out -> escape;
+	const LSCg_t *glyphs = out -> glyphs;
+
+	if(cw == 1 && !glyphs) {
+		*data++ = *cell;
+		return data;
+	}
+
+	for(size_t i = 0; i < 2 * half; i += half) {
+		if(out -> styled && !memcmp(out -> style + i, cell + i, half))
+			continue;
+
+		memcpy(data, cell + i, half);
+		memcpy(out -> style + i, cell + i, half);
+		data += half;
+	}
+
+	if(half) out -> styled = true;
+
+	if(!glyphs) {
+		memcpy(data, cell + 2 * half, cw - 2 * half);
+		return data + cw - 2 * half;
+	}
+
+	const uint8_t id = cell[cw - 1];
+	if(glyphs -> wide[id] && !room) {
+		*data++ = ' ';
+		return data;
+	}
+
+	memcpy(data, glyphs -> utf8[id], 4);
+	return data + glyphs -> len[id];
+}
+
+/* With a glyph table, a cell holds the ID of its glyph in place of the glyph
+ * itself, and the UTF-8 is only looked up here. A wide glyph covers the cell
+ * after it too, whose contents are then never sent, and one in the last
+ * column, where it wouldn't fit, goes out as a space. */
+
+static bool wide(const LSCo_t *out, const char *cell, size_t cw) {
+	return out -> glyphs && out -> glyphs -> wide[(uint8_t) cell[cw - 1]];
+}
+
+static int full(LSCo_t *out, LSCb_t *buf) {
+	const size_t len = buf -> chwidth * buf -> width * buf -> height;
+
+	if(!out -> shadow || out -> chwidth * out -> width * out -> height
+		!= len)
+	{
+		char *shadow = realloc(out -> shadow, len);
+		if(!shadow) {
+			if(LSCe_auto) perror("stdlib");
+			LSC_errno = LSC_MALLOC_ERR;
+			return LSCE_NOOP;
+		}
+
+		out -> shadow = shadow;
+	}
+
+	if(!out -> hashes || out -> height != buf -> height) {
+		uint64_t *hashes = realloc(out -> hashes,
+			sizeof(uint64_t) * buf -> height);
+
+		if(!hashes) {
+			if(LSCe_auto) perror("stdlib");
+			LSC_errno = LSC_MALLOC_ERR;
+			return LSCE_NOOP;
+		}
+
+		out -> hashes = hashes;
+	}
+
+	const size_t cw = buf -> chwidth;
+	const size_t extra = buf -> glyphs? 3 * buf -> width * buf -> height: 0;
+	if(reserve(out, len + extra + 64) != LSCE_OK) return LSCE_NOOP;
+
+	char *data = cup(out -> data + out -> used, out -> y, 1);
+
+	out -> escape = escape(buf);
+	out -> glyphs = buf -> glyphs;
+	out -> styled = false;
+
+	if(!out -> escape && !out -> glyphs) {
+		memcpy(data, buf -> data, len);
+		data += len;
+	}
+
+	else for(size_t y = 0; y < buf -> height; y++) {
+		const char *row = buf -> data + cw * buf -> width * y;
+
+		for(size_t x = 0; x < buf -> width; x++) {
+			const bool room = x + 1 < buf -> width;
+			data = emit(out, data, row + cw * x, cw, room);
+			if(room && wide(out, row + cw * x, cw)) x++;
+		}
+	}
+
+	LSCS_ADD(encoded, data - out -> data - out -> used);
+	out -> used = data - out -> data;
+
+	memcpy(out -> shadow, buf -> data, len);
+
+	const size_t row = buf -> chwidth * buf -> width;
+	for(size_t y = 0; y < buf -> height; y++)
+		out -> hashes[y] = LSCo_hash(buf -> data + y * row, row);
+
+	out -> colour = buf -> colour;
+	out -> chwidth = buf -> chwidth;
+	out -> height = buf -> height;
+	out -> width = buf -> width;
+	out -> valid = true;
+
+	return LSCE_OK;
+}
+
+static size_t digits(size_t n) {
+	size_t len = 1;
+	while(n >= 10) { n /= 10; len++; }
+	return len;
+}
+
+/* Moves the cursor from (cx, cy) to (x, y) with whichever of an absolute move,
+ * a relative move right or simply re-emitting the cells in between takes the
+ * fewest bytes. Starting a row just below the cursor can also begin with a
+ * CR LF. A cursor just past the last column is in the terminal's pending wrap
+ * state, where printing carries on at the start of the next row but relative
+ * moves are unreliable, so only printing is considered from there. */
+
+static char *seek(LSCo_t *out, char *data, const char *row, size_t cw,
+	size_t cx, size_t cy, size_t x, size_t y, size_t width)
+{
+	if(cy == SIZE_MAX) return cup(data, out -> y + y, x + 1);
+
+	const bool wrap = cx == width;
+	if(wrap) { cx = 0; cy++; }
+	if(cx == x && cy == y) return data;
+
+	size_t best = 4 + digits(out -> y + y) + digits(x + 1);
+	bool crlf = false;
+
+	if(cy + 1 == y && !wrap) {
+		crlf = true;
+		cx = 0; cy++;
+	}
+
+	if(cy != y || cx > x) return cup(data, out -> y + y, x + 1);
+
+	const size_t n = x - cx;
+	const size_t rel = crlf * 2 + (n? 3 + (n > 1) * digits(n): 0);
+	const size_t same = out -> glyphs? SIZE_MAX: crlf * 2 + n * cw;
+
+	if(same <= best && same <= rel) {
+		if(crlf) { *data++ = '\r'; *data++ = '\n'; }
+		for(size_t i = cx; i < x; i++)
+			data = emit(out, data, row + cw * i, cw, true);
+
+		return data;
+	}
+
+	if(rel < best && !wrap) {
+		if(crlf) { *data++ = '\r'; *data++ = '\n'; }
+		if(!n) return data;
+
+		*data++ = '\033'; *data++ = '[';
+		if(n > 1) data = number(data, n);
+		*data++ = 'C';
+		return data;
+	}
+
+	return cup(data, out -> y + y, x + 1);
+}
+
+/* Rows whose stamp predates the last encode can't have changed and are skipped
+ * without looking at them. The rest are hashed, and only those whose hash no
+ * longer matches the shadow's are diffed cell by cell. With a cache shared
+ * between presenters, each changed row is encoded from a clean cursor so that
+ * presenters starting from the same row can reuse the bytes as they are. */
+
+static void diff(LSCo_t *out, LSCb_t *buf, bool stamped, uint64_t seen) {
+	const size_t cw = buf -> chwidth, len = cw * buf -> width;
+	LSCo_row_t *cache = out -> cached == buf -> height? out -> cache: NULL;
+
+	char *data = out -> data + out -> used;
+	size_t cx = SIZE_MAX, cy = SIZE_MAX;
+
+	for(size_t y = 0; y < buf -> height; y++) {
+		if(stamped && buf -> rows[y] < seen) continue;
+
+		const char *row = buf -> data + len * y;
+		char *shadow = out -> shadow + len * y;
+
+		const uint64_t hash = LSCo_hash(row, len);
+		const uint64_t from = out -> hashes[y];
+		if(hash == from) continue;
+
+		out -> hashes[y] = hash;
+		LSCo_row_t *entry = cache? &cache[y]: NULL;
+		const char *start = data;
+
+		if(entry) {
+			cx = cy = SIZE_MAX;
+			out -> styled = false;
+		}
+
+		if(entry && entry -> valid && entry -> from == from
+			&& entry -> to == hash && entry -> y == out -> y
+			&& entry -> width == buf -> width)
+		{
+			memcpy(data, entry -> data, entry -> len);
+			memcpy(shadow, row, len);
+
+			data += entry -> len;
+			continue;
+		}
+
+		bool was = false, now = false;
+
+		for(size_t x = 0; x < buf -> width; x++) {
+			const char *cell = row + cw * x;
+			char *old = shadow + cw * x;
+
+			const bool room = x + 1 < buf -> width;
+			const bool waswide = !was && room
+				&& wide(out, old, cw);
+
+			const bool nowwide = !now && room
+				&& wide(out, cell, cw);
+
+			if(was != now || memcmp(cell, old, cw)) {
+				if(!now) {
+					data = seek(out, data, row, cw, cx, cy,
+						x, y, buf -> width);
+
+					data = emit(out, data, cell, cw, room);
+					cx = x + 1 + nowwide;
+					cy = y;
+				}
+
+				memcpy(old, cell, cw);
+			}
+
+			was = waswide;
+			now = nowwide;
+		}
+
+		if(entry) store(out, entry, from, hash, start, data - start);
+	}
+
+	LSCS_ADD(encoded, data - out -> data - out -> used);
+	out -> used = data - out -> data;
+}
+
+int LSCo_encode(LSCo_t *out, LSCb_t *buf) {
+	LSCX_BEGIN("encode");
+	LSCS_START(encoding);
+
+	const size_t start = out -> used;
+	int ret = LSCE_OK;
+
+	if(out -> sync && (ret = reserve(out, 8)) == LSCE_OK) {
+		memcpy(out -> data + out -> used, "\033[?2026h", 8);
+		out -> used += 8;
+	}
+
+	const bool fresh = !out -> valid || out -> colour != buf -> colour
+		|| out -> chwidth != buf -> chwidth
+		|| out -> escape != escape(buf)
+		|| out -> glyphs != buf -> glyphs
+		|| out -> height != buf -> height
+		|| out -> width != buf -> width;
+
+	const bool stamped = buf -> rows && out -> source == buf;
+	const uint64_t seen = out -> seen;
+
+	out -> source = buf;
+	if(buf -> rows) out -> seen = ++buf -> epoch;
+
+	if(ret == LSCE_OK && fresh) ret = full(out, buf);
+
+	else if(ret == LSCE_OK) {
+		ret = reserve(out, buf -> width * buf -> height
+			* (buf -> chwidth + 48) + 16);
+
+		if(ret == LSCE_OK) diff(out, buf, stamped, seen);
+	}
+
+	if(out -> sync) {
+		if(ret != LSCE_OK || out -> used == start + 8)
+			out -> used = start;
+
+		else {
+			memcpy(out -> data + out -> used, "\033[?2026l", 8);
+			out -> used += 8;
+			LSCS_ADD(encoded, 16);
+		}
+	}
+
+	if(ret != LSCE_OK) out -> valid = false;
+
+	LSCS_STOP(encode_ns, encoding);
+	LSCX_END("encode");
+
+	LSCS_ADD(frames, 1);
+	return ret;
+}
+
+int LSCo_flush(LSCo_t *out) {
+	if(out -> fd < 0) {
+		out -> sent = out -> used = 0;
+		return LSCE_OK;
+	}
+
+	LSCX_BEGIN("write");
+	LSCS_START(writing);
+
+	while(out -> sent < out -> used) {
+		ssize_t ret = write(out -> fd, out -> data + out -> sent,
+			out -> used - out -> sent);
+
+		if(ret == -1) {
+			if(errno == EINTR) continue;
+			if(errno == EAGAIN || errno == EWOULDBLOCK) break;
+
+			LSCX_END("write");
+			if(LSCe_auto) perror("unistd");
+			LSC_errno = LSC_WRITE_ERR;
+			return LSCE_NOOP;
+		}
+
+		LSCS_ADD(sent, ret);
+		out -> sent += ret;
+	}
+
+	if(out -> sent == out -> used) out -> sent = out -> used = 0;
+
+	LSCS_STOP(write_ns, writing);
+	LSCX_END("write");
+	return LSCE_OK;
+}
+
+/* A frame that has started going out cannot be taken back, so a newer frame
+ * waits in pending until it has finished. Since the shadow already holds what
+ * the terminal will show once it has, the newest frame is then sent as one
+ * diff covering everything that was skipped in between. */
+
+int LSCo_present(LSCo_t *out, LSCb_t *buf) {
+	if(out -> pending) LSCS_ADD(dropped, 1);
+
+	out -> pending = buf;
+	return LSCo_resume(out);
+}
+
+int LSCo_resume(LSCo_t *out) {
+	if(LSCo_flush(out) != LSCE_OK) return LSCE_NOOP;
+	if(out -> used || !out -> pending) return LSCE_OK;
+
+	int ret = LSCo_encode(out, out -> pending);
+	out -> pending = NULL;
+
+	if(ret != LSCE_OK) return ret;
+	return LSCo_flush(out);
+}
+
+int LSCo_nonblock(LSCo_t *out, bool nonblock) {
+	int flags = fcntl(out -> fd, F_GETFL);
+	if(flags != -1) flags = fcntl(out -> fd, F_SETFL,
+		nonblock? flags | O_NONBLOCK: flags & ~O_NONBLOCK);
+
+	if(flags == -1) {
+		if(LSCe_auto) perror("fcntl");
+		LSC_errno = LSC_FCNTL_ERR;
+		return LSCE_NOOP;
+	}
+
+	return LSCE_OK;
+}
+
+bool LSCo_busy(LSCo_t *out) {
+	return out -> used || out -> pending;
+}
+
+void LSCo_pollfd(LSCo_t *out, struct pollfd *pfd) {
+	pfd -> fd = out -> fd;
+	pfd -> events = LSCo_busy(out)? POLLOUT: 0;
+	pfd -> revents = 0;
+}
@@ -0,0 +1,227 @@
+/* libScricon: The Simple Graphical Console Library
+ * Copyright (C) 2021-2022 Jyothiraditya Nellakra
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <LSC_buffer.h>
+#include <LSC_colour.h>
+#include <LSC_error.h>
+#include <LSC_particles.h>
+#include <LSC_quantize.h>
+#include <LSC_trace.h>
+
+#include "LSC_cell.h"
+
+void LSCp_init(LSCp_t *ps) {
+	ps -> count = 0;
+	ps -> capacity = 1024;
+
+	ps -> x = ps -> y = ps -> z = NULL;
+	ps -> dx = ps -> dy = NULL;
+	ps -> life = NULL;
+
+	ps -> chr = NULL;
+	ps -> fg = NULL;
+
+	ps -> block = NULL;
+}
+
+static size_t pad(size_t size) {
+	return (size + LSCB_ALIGN - 1) & ~(size_t) (LSCB_ALIGN - 1);
+}
+
+/* Every field gets an array of its own, each starting on a fresh cache line,
+ * so that the update loops run over contiguous floats and vectorise. */
+
+int LSCp_alloc(LSCp_t *ps) {
+	LSCq_init();
+
+	const size_t floats = pad(sizeof(float) * ps -> capacity);
+	const size_t bytes = pad(ps -> capacity);
+
+	char *block = aligned_alloc(LSCB_ALIGN, 6 * floats + 2 * bytes);
+	if(!block) {
+		if(LSCe_auto) perror("stdlib");
+		LSC_errno = LSC_MALLOC_ERR;
+		return LSCE_NOOP;
+	}
+
+	free(ps -> block);
+	ps -> block = block;
+	ps -> count = 0;
+
+	ps -> x = (float *) block;
+	ps -> y = (float *) (block + floats);
+	ps -> z = (float *) (block + 2 * floats);
+	ps -> dx = (float *) (block + 3 * floats);
+	ps -> dy = (float *) (block + 4 * floats);
+	ps -> life = (float *) (block + 5 * floats);
+
+	ps -> chr = block + 6 * floats;
+	ps -> fg = (uint8_t *) block + 6 * floats + bytes;
+
+	return LSCE_OK;
+}
+
+void LSCp_free(LSCp_t *ps) {
+	const size_t capacity = ps -> capacity;
+
+	free(ps -> block);
+	LSCp_init(ps);
+	ps -> capacity = capacity;
+}
+
+/* New particles are appended, so the first of them is at the old count. They
+ * start out zeroed, which leaves the caller to fill in at least their life,
+ * and as many are spawned as there is room for. */
+
+size_t LSCp_spawn(LSCp_t *ps, size_t count) {
+	const size_t first = ps -> count;
+	if(count > ps -> capacity - first) count = ps -> capacity - first;
+
+	float *floats[] = {ps -> x, ps -> y, ps -> z, ps -> dx, ps -> dy,
+		ps -> life};
+
+	for(size_t i = 0; i < 6; i++)
+		memset(floats[i] + first, 0, sizeof(float) * count);
+
+	memset(ps -> chr + first, ' ', count);
+	memset(ps -> fg + first, 0, count);
+
+	ps -> count += count;
+	return count;
+}
+
+static void move(LSCp_t *ps, size_t to, size_t from) {
+	ps -> x[to] = ps -> x[from];
+	ps -> y[to] = ps -> y[from];
+	ps -> z[to] = ps -> z[from];
+	ps -> dx[to] = ps -> dx[from];
+	ps -> dy[to] = ps -> dy[from];
+	ps -> life[to] = ps -> life[from];
+	ps -> chr[to] = ps -> chr[from];
+	ps -> fg[to] = ps -> fg[from];
+}
+
+void LSCp_kill(LSCp_t *ps, size_t i) {
+	move(ps, i, --ps -> count);
+}
+
+/* Dead particles are replaced by the last live one, which keeps the arrays
+ * packed without shifting them, at the cost of not keeping their order. */
+
+size_t LSCp_reap(LSCp_t *ps) {
+	const size_t count = ps -> count;
+
+	for(size_t i = 0; i < ps -> count;) {
+		if(ps -> life[i] > 0.0f) i++;
+		else LSCp_kill(ps, i);
+	}
+
+	return count - ps -> count;
+}
+
+void LSCp_update(LSCp_t *ps, float dt, float ax, float ay) {
+	LSCX_BEGIN("update");
+
+	float *restrict x = ps -> x, *restrict y = ps -> y;
+	float *restrict dx = ps -> dx, *restrict dy = ps -> dy;
+	float *restrict life = ps -> life;
+
+	for(size_t i = 0; i < ps -> count; i++) {
+		x[i] += dx[i] * dt;
+		y[i] += dy[i] * dt;
+
+		dx[i] += ax * dt;
+		dy[i] += ay * dt;
+		life[i] -= dt;
+	}
+
+	LSCX_END("update");
+}
+
+void LSCp_clip(LSCp_t *ps, float width, float height) {
+	const float *restrict x = ps -> x, *restrict y = ps -> y;
+	float *restrict life = ps -> life;
+
+	for(size_t i = 0; i < ps -> count; i++) {
+		const bool in = x[i] >= 0.0f && x[i] < width
+			&& y[i] >= 0.0f && y[i] < height;
+
+		life[i] = in? life[i]: 0.0f;
+	}
+}
+
+/* Particles are only moved back by a single width or height, which is all a
+ * particle that moves less than that per update ever needs, and keeps the
+ * loop free of calls so that it vectorises. */
+
+void LSCp_wrap(LSCp_t *ps, float width, float height) {
+	float *restrict x = ps -> x, *restrict y = ps -> y;
+
+	for(size_t i = 0; i < ps -> count; i++) {
+		x[i] += x[i] < 0.0f? width: x[i] >= width? -width: 0.0f;
+		y[i] += y[i] < 0.0f? height: y[i] >= height? -height: 0.0f;
+	}
+}
+
+/* Particles write their glyph and foreground colour and leave the background
+ * alone, so that they can be scattered over a scene. With depth, they are
+ * tested against and write to the depth buffer as the z setters do. */
+
+static void splat(LSCp_t *ps, LSCb_t *buf, bool depth) {
+	LSCX_BEGIN("splat");
+
+	for(size_t i = 0; i < ps -> count; i++) {
+		const float fx = ps -> x[i], fy = ps -> y[i];
+		if(!(fx >= 0.0f && fy >= 0.0f)) continue;
+
+		const size_t x = fx, y = fy;
+		if(x >= buf -> width || y >= buf -> height) continue;
+
+		const size_t cell = x + y * buf -> width;
+
+		if(depth) {
+			if(LSCb_occluded(buf, cell, ps -> z[i])) continue;
+			buf -> zdata[cell] = ps -> z[i];
+		}
+
+		char *data = buf -> data + buf -> chwidth * cell;
+
+		if(buf -> truecolour)
+			LSCc_rgbfg(data + 19, LSCq_palette[ps -> fg[i]]);
+
+		else if(buf -> colour) LSCc_fg(data + 11, ps -> fg[i]);
+
+		data[buf -> chwidth - 1] = ps -> chr[i];
+		LSCb_mark(buf, x, y);
+	}
+
+	LSCX_END("splat");
+}
+
+void LSCp_splat(LSCp_t *ps, LSCb_t *buf) {
+	splat(ps, buf, false);
+}
+
+void LSCp_splatz(LSCp_t *ps, LSCb_t *buf) {
+	splat(ps, buf, true);
+}
@@ -0,0 +1,168 @@
+/* libScricon: The Simple Graphical Console Library
+ * Copyright (C) 2021-2022 Jyothiraditya Nellakra
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <threads.h>
+
+#include <LSC_buffer.h>
+#include <LSC_colour.h>
+#include <LSC_quantize.h>
+
+uint32_t LSCq_palette[256];
+uint8_t LSCq_lut[32][32][32];
+
+static const uint32_t system[16] = {
+	0x000000, 0xcd0000, 0x00cd00, 0xcdcd00,
+	0x0000ee, 0xcd00cd, 0x00cdcd, 0xe5e5e5,
+	0x7f7f7f, 0xff0000, 0x00ff00, 0xffff00,
+	0x5c5cff, 0xff00ff, 0x00ffff, 0xffffff
+};
+
+static const uint8_t levels[6] = {0, 95, 135, 175, 215, 255};
+
+static const uint8_t bayer[4][4] = {
+	{0, 8, 2, 10}, {12, 4, 14, 6}, {3, 11, 1, 9}, {15, 7, 13, 5}
+};
+
+static once_flag once = ONCE_FLAG_INIT;
+
+static size_t level(int v) {
+	return v < 48? 0: v < 115? 1: (size_t) (v - 35) / 40;
+}
+
+static uint32_t distance(uint32_t rgb, int r, int g, int b) {
+	const int dr = (int) (rgb >> 16 & 0xff) - r;
+	const int dg = (int) (rgb >> 8 & 0xff) - g;
+	const int db = (int) (rgb & 0xff) - b;
+	return 2 * dr * dr + 4 * dg * dg + 3 * db * db;
+}
+
+/* The first 16 colours are left out of the table, since most terminals let
+ * the user theme them. Within the colour cube the nearest entry can be found
+ * one channel at a time, so only the greys need an actual search. */
+
+static uint8_t nearest(int r, int g, int b) {
+	uint8_t best = 16 + 36 * level(r) + 6 * level(g) + level(b);
+	uint32_t least = distance(LSCq_palette[best], r, g, b);
+
+	for(unsigned i = 232; i < 256; i++) {
+		const uint32_t dist = distance(LSCq_palette[i], r, g, b);
+		if(dist < least) { least = dist; best = i; }
+	}
+
+	return best;
+}
+
+static void build(void) {
+	for(unsigned i = 0; i < 16; i++) LSCq_palette[i] = system[i];
+
+	for(unsigned i = 0; i < 216; i++) LSCq_palette[16 + i] =
+		LSCC_RGB(levels[i / 36], levels[i / 6 % 6], levels[i % 6]);
+
+	for(unsigned i = 0; i < 24; i++)
+		LSCq_palette[232 + i] = 0x010101 * (8 + 10 * i);
+
+	for(unsigned r = 0; r < 32; r++)
+		for(unsigned g = 0; g < 32; g++)
+			for(unsigned b = 0; b < 32; b++)
+	{
+		LSCq_lut[r][g][b] = nearest(r << 3 | 4, g << 3 | 4, b << 3 | 4);
+	}
+}
+
+void LSCq_init(void) {
+	call_once(&once, build);
+}
+
+void LSCq_row(uint8_t *dst, const uint8_t *rgb, size_t count) {
+	LSCq_init();
+
+	for(size_t i = 0; i < count; i++)
+		dst[i] = LSCq_index(rgb[3 * i], rgb[3 * i + 1], rgb[3 * i + 2]);
+}
+
+void LSCq_rowp(uint8_t *dst, const uint32_t *rgb, size_t count) {
+	LSCq_init();
+	for(size_t i = 0; i < count; i++) dst[i] = LSCq_packed(rgb[i]);
+}
+
+static uint8_t clamp(int v) {
+	return v < 0? 0: v > 255? 255: v;
+}
+
+/* Ordered dithering nudges each channel by up to half a step of the colour
+ * cube, following a 4x4 Bayer matrix anchored to the cell's position so that
+ * the pattern stays put from one frame to the next. */
+
+void LSCq_dither(uint8_t *dst, const uint8_t *rgb, size_t count,
+	size_t x, size_t y)
+{
+	LSCq_init();
+
+	for(size_t i = 0; i < count; i++) {
+		const int offset = bayer[y & 3][(x + i) & 3] * 40 / 16 - 20;
+
+		dst[i] = LSCq_index(clamp(rgb[3 * i] + offset),
+			clamp(rgb[3 * i + 1] + offset),
+			clamp(rgb[3 * i + 2] + offset));
+	}
+}
+
+static void row(LSCb_t *buf, size_t x, size_t y, const uint8_t *rgb,
+	size_t count, bool dither, bool fg)
+{
+	if(!buf -> colour) return;
+
+	if(buf -> truecolour) {
+		for(size_t i = 0; i < count; i++) {
+			const uint32_t col = LSCC_RGB(rgb[3 * i],
+				rgb[3 * i + 1], rgb[3 * i + 2]);
+
+			if(fg) LSCb_setfgrgb(buf, x + i, y, col);
+			else LSCb_setbgrgb(buf, x + i, y, col);
+		}
+
+		return;
+	}
+
+	uint8_t index[256];
+	for(size_t i = 0; i < count; i += sizeof(index)) {
+		const size_t len = count - i < sizeof(index)?
+			count - i: sizeof(index);
+
+		if(dither) LSCq_dither(index, rgb + 3 * i, len, x + i, y);
+		else LSCq_row(index, rgb + 3 * i, len);
+
+		for(size_t j = 0; j < len; j++) {
+			if(fg) LSCb_setfg(buf, x + i + j, y, index[j]);
+			else LSCb_setbg(buf, x + i + j, y, index[j]);
+		}
+	}
+}
+
+void LSCq_fgrow(LSCb_t *buf, size_t x, size_t y, const uint8_t *rgb,
+	size_t count, bool dither)
+{
+	row(buf, x, y, rgb, count, dither, true);
+}
+
+void LSCq_bgrow(LSCb_t *buf, size_t x, size_t y, const uint8_t *rgb,
+	size_t count, bool dither)
+{
+	row(buf, x, y, rgb, count, dither, false);
+}
@@ -0,0 +1,156 @@
+/* libScricon: The Simple Graphical Console Library
+ * Copyright (C) 2021-2022 Jyothiraditya Nellakra
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <threads.h>
+#include <time.h>
+
+#include <LSC_buffer.h>
+#include <LSC_colour.h>
+#include <LSC_quantize.h>
+#include <LSC_random.h>
+#include <LSC_stats.h>
+
+thread_local LSCr_t LSCr_local;
+static thread_local bool seeded;
+
+/* xoshiro256** can't start from all zeroes, so the seed is spread over the
+ * state with splitmix64, which never gives four zeroes in a row. */
+
+void LSCr_seed(LSCr_t *rng, uint64_t seed) {
+	for(size_t i = 0; i < 4; i++) {
+		uint64_t z = (seed += UINT64_C(0x9e3779b97f4a7c15));
+		z = (z ^ (z >> 30)) * UINT64_C(0xbf58476d1ce4e5b9);
+		z = (z ^ (z >> 27)) * UINT64_C(0x94d049bb133111eb);
+		rng -> s[i] = z ^ (z >> 31);
+	}
+}
+
+/* Each thread's generator is seeded the first time it is asked for, from the
+ * clock and the address of its state, which differs between threads. */
+
+LSCr_t *LSCr_thread(void) {
+	if(!seeded) {
+		struct timespec ts;
+		timespec_get(&ts, TIME_UTC);
+
+		const uint64_t ns = (uint64_t) ts.tv_sec * 1000000000
+			+ ts.tv_nsec;
+
+		LSCr_seed(&LSCr_local, ns ^ (uintptr_t) &LSCr_local);
+
+		seeded = true;
+	}
+
+	return &LSCr_local;
+}
+
+void LSCr_bytes(LSCr_t *rng, void *dst, size_t size) {
+	char *data = dst;
+
+	for(; size >= 8; data += 8, size -= 8) {
+		const uint64_t word = LSCr_next(rng);
+		memcpy(data, &word, 8);
+	}
+
+	if(size) {
+		const uint64_t word = LSCr_next(rng);
+		memcpy(data, &word, size);
+	}
+}
+
+/* Any of the three lists can be left empty to leave that part of the cells
+ * alone, and the colours are only set on colour buffers. On truecolour ones,
+ * the picked palette entries are written out as RGB. */
+
+static void cell(LSCr_t *rng, LSCb_t *buf, size_t x, size_t y,
+	const LSCr_pick_t *pick)
+{
+	const bool colour = buf -> colour, rgb = buf -> truecolour;
+
+	if(colour && pick -> len_fgs) {
+		const size_t i = LSCr_below(rng, pick -> len_fgs);
+		if(rgb) LSCb_setfgrgb(buf, x, y, LSCq_palette[pick -> fgs[i]]);
+		else LSCb_setfg(buf, x, y, pick -> fgs[i]);
+	}
+
+	if(colour && pick -> len_bgs) {
+		const size_t i = LSCr_below(rng, pick -> len_bgs);
+		if(rgb) LSCb_setbgrgb(buf, x, y, LSCq_palette[pick -> bgs[i]]);
+		else LSCb_setbg(buf, x, y, pick -> bgs[i]);
+	}
+
+	if(pick -> len_chrs) LSCb_set(buf, x, y,
+		pick -> chrs[LSCr_below(rng, pick -> len_chrs)]);
+}
+
+/* Whole rows are written in place and marked dirty in one go at the end,
+ * which leaves little more than the random numbers themselves per cell. */
+
+void LSCr_fill(LSCr_t *rng, LSCb_t *buf, size_t y, size_t height,
+	const LSCr_pick_t *pick)
+{
+	if(buf -> truecolour) LSCq_init();
+
+	const bool rgb = buf -> truecolour;
+	const bool fgs = buf -> colour && pick -> len_fgs;
+	const bool bgs = buf -> colour && pick -> len_bgs;
+
+	const size_t cw = buf -> chwidth, half = rgb? 19: 11;
+	const size_t first = buf -> width * y, cells = buf -> width * height;
+	char *data = buf -> data + cw * first;
+
+	for(size_t i = 0; i < cells; i++, data += cw) {
+		if(bgs) {
+			const size_t j = LSCr_below(rng, pick -> len_bgs);
+			if(rgb) LSCc_rgbbg(data, LSCq_palette[pick -> bgs[j]]);
+			else LSCc_bg(data, pick -> bgs[j]);
+		}
+
+		if(fgs) {
+			const size_t j = LSCr_below(rng, pick -> len_fgs);
+			if(rgb) LSCc_rgbfg(data + half,
+				LSCq_palette[pick -> fgs[j]]);
+
+			else LSCc_fg(data + half, pick -> fgs[j]);
+		}
+
+		if(pick -> len_chrs) data[cw - 1]
+			= pick -> chrs[LSCr_below(rng, pick -> len_chrs)];
+	}
+
+	if(buf -> wdata)
+		for(size_t i = first; i < first + cells; i++) buf -> wdata[i]++;
+
+	LSCS_ADD(written, cells);
+	LSCb_dirty(buf, 0, y, buf -> width, height);
+}
+
+void LSCr_scatter(LSCr_t *rng, LSCb_t *buf, size_t count,
+	const LSCr_pick_t *pick)
+{
+	if(!buf -> width || !buf -> height) return;
+	if(buf -> truecolour) LSCq_init();
+
+	for(size_t i = 0; i < count; i++) {
+		const size_t x = LSCr_below(rng, buf -> width);
+		const size_t y = LSCr_below(rng, buf -> height);
+		cell(rng, buf, x, y, pick);
+	}
+}
@@ -20,6 +20,26 @@
 #include <string.h>
 
 #include <LSC_buffer.h>
+#include <LSC_stats.h>
+#include <LSC_trace.h>
+
+static void scroll_down(LSCb_t *buf, intmax_t lines) {
+	for(intmax_t i = buf -> height - 1; i >= lines; i--) {
+		memcpy(buf -> data + buf -> chwidth * i * buf -> width,
+			buf -> data + buf -> chwidth * (i - lines) * buf -> width,
+			buf -> chwidth * buf -> width);
+	}
+
+	for(intmax_t i = 0; i < lines; i++)
+		for(size_t j = 0; j < buf -> width; j++)
+	{
+		if(buf -> chwidth > 1) memcpy(buf -> data
+			+ buf -> chwidth * (i * buf -> width + j),
+			buf -> cchs, buf -> chwidth);
+
+		else buf -> data[i * buf -> width + j] = buf -> cch;
+	}
+}
 
 static void scroll_up(LSCb_t *buf, intmax_t lines) {
 	for(size_t i = 0; i < buf -> height - lines; i++) {
@@ -31,30 +51,23 @@ static void scroll_up(LSCb_t *buf, intmax_t lines) {
 	for(size_t i = buf -> height - lines; i < buf -> height; i++)
 		for(size_t j = 0; j < buf -> width; j++)
 	{
-		memcpy(buf -> data + buf -> chwidth * (i * buf -> width + j),
-			LSCb_cch, buf -> chwidth);
+		if(buf -> chwidth > 1) memcpy(buf -> data
+			+ buf -> chwidth * (i * buf -> width + j),
+			buf -> cchs, buf -> chwidth);
+
+		else buf -> data[i * buf -> width + j] = buf -> cch;
 	}
 }
 
 void LSC_scrollv(LSCb_t *buf, intmax_t lines) {
 	if(lines == 0) return;
 
-	if(lines < 0) {
-		scroll_up(buf, imaxabs(lines));
-		return;
-	}
+	LSCX_BEGIN("scroll");
+	LSCS_ADD(scrolls, 1);
 
-	lines = imaxabs(lines);
-	for(intmax_t i = buf -> height - 1; i >= lines; i--) {
-		memcpy(buf -> data + buf -> chwidth * i * buf -> width,
-			buf -> data + buf -> chwidth * (i - lines) * buf -> width,
-			buf -> chwidth * buf -> width);
-	}
+	if(lines < 0) scroll_up(buf, imaxabs(lines));
+	else scroll_down(buf, lines);
 
-	for(intmax_t i = 0; i < lines; i++)
-		for(size_t j = 0; j < buf -> width; j++)
-	{
-		memcpy(buf -> data + buf -> chwidth * (i * buf -> width + j),
-			LSCb_cch, buf -> chwidth);
-	}
+	LSCb_touch(buf, 0, buf -> height);
+	LSCX_END("scroll");
 }
\ No newline at end of file
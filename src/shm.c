@@ -0,0 +1,256 @@
+/* libScricon: The Simple Graphical Console Library
+ * Copyright (C) 2021-2022 Jyothiraditya Nellakra
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#define _GNU_SOURCE
+
+#include <fcntl.h>
+#include <float.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <LSC_buffer.h>
+#include <LSC_error.h>
+#include <LSC_shm.h>
+
+#define MAGIC UINT64_C(0x324d43534c)
+#define FRESH 4u
+
+/* The mapping starts with this header, followed by three slots laid out like
+ * an LSCb_t block. The producer owns one slot and the presenter another; the
+ * third is the latest published frame, whose index lives in state along with
+ * a flag saying whether the presenter has picked it up yet. */
+
+typedef struct {
+	uint64_t magic;
+	uint64_t colour;
+	uint64_t glyph;
+	uint64_t width;
+	uint64_t height;
+	uint64_t stride;
+
+	atomic_uint state;
+} header_t;
+
+static size_t pad(size_t size) {
+	return (size + LSCB_ALIGN - 1) & ~(size_t) (LSCB_ALIGN - 1);
+}
+
+static void point(LSCm_t *shm) {
+	const size_t cells = shm -> buf.width * shm -> buf.height;
+	const size_t zsize = pad(sizeof(double) * cells);
+	const size_t ssize = pad(sizeof(uint64_t) * shm -> buf.height);
+	const size_t rsize = ssize
+		+ pad(LSCb_tiles(shm -> buf.width, shm -> buf.height));
+
+	char *slot = (char *) shm -> map + pad(sizeof(header_t))
+		+ shm -> slot * shm -> stride;
+
+	shm -> buf.zdata = (double *) slot;
+	shm -> buf.rows = shm -> owner? (uint64_t *) (slot + zsize): NULL;
+	shm -> buf.tiles = shm -> owner? (uint8_t *) slot + zsize + ssize: NULL;
+	shm -> buf.data = slot + zsize + rsize;
+}
+
+void LSCm_init(LSCm_t *shm) {
+	LSCb_init(&shm -> buf);
+
+	shm -> fd = -1;
+	shm -> name = NULL;
+	shm -> owner = false;
+
+	shm -> map = NULL;
+	shm -> size = 0;
+	shm -> stride = 0;
+	shm -> slot = 0;
+}
+
+void LSCm_free(LSCm_t *shm) {
+	if(shm -> map) munmap(shm -> map, shm -> size);
+	if(shm -> fd != -1) close(shm -> fd);
+	if(shm -> owner && shm -> name) shm_unlink(shm -> name);
+
+	LSCb_heatoff(&shm -> buf);
+	shm -> buf.data = NULL;
+	shm -> buf.zdata = NULL;
+	shm -> buf.rows = NULL;
+	shm -> buf.tiles = NULL;
+
+	shm -> fd = -1;
+	shm -> owner = false;
+	shm -> map = NULL;
+}
+
+static int fail(LSCm_t *shm, const char *what) {
+	if(LSCe_auto) perror(what);
+	LSC_errno = LSC_SHM_ERR;
+
+	LSCm_free(shm);
+	return LSCE_NOOP;
+}
+
+int LSCm_create(LSCm_t *shm, const char *name) {
+	LSCb_t *buf = &shm -> buf;
+	if(buf -> truecolour && buf -> cchs == LSCb_cch)
+		buf -> cchs = LSCb_rgbch;
+
+	buf -> chwidth = LSCb_chwidth(buf);
+
+	const size_t cells = buf -> width * buf -> height;
+	shm -> stride = pad(sizeof(double) * cells)
+		+ pad(sizeof(uint64_t) * buf -> height)
+		+ pad(LSCb_tiles(buf -> width, buf -> height))
+		+ pad(buf -> chwidth * cells + 1);
+
+	shm -> size = pad(sizeof(header_t)) + 3 * shm -> stride;
+	shm -> name = name;
+	shm -> owner = true;
+
+	shm -> fd = name? shm_open(name, O_CREAT | O_TRUNC | O_RDWR, 0600):
+		memfd_create("libScricon", 0);
+
+	if(shm -> fd == -1) return fail(shm, "mman");
+	if(ftruncate(shm -> fd, shm -> size) == -1) return fail(shm, "unistd");
+
+	shm -> map = mmap(NULL, shm -> size, PROT_READ | PROT_WRITE,
+		MAP_SHARED, shm -> fd, 0);
+
+	if(shm -> map == MAP_FAILED) {
+		shm -> map = NULL;
+		return fail(shm, "mman");
+	}
+
+	header_t *head = shm -> map;
+	head -> magic = MAGIC;
+	head -> colour = buf -> colour? 1 + buf -> truecolour: 0;
+	head -> glyph = buf -> glyph;
+	head -> width = buf -> width;
+	head -> height = buf -> height;
+	head -> stride = shm -> stride;
+
+	atomic_init(&head -> state, 1);
+
+	for(unsigned i = 0; i < 3; i++) {
+		shm -> slot = 2 - i;
+		point(shm);
+
+		LSCb_clear(buf);
+		buf -> data[buf -> chwidth * cells] = 0;
+	}
+
+	return LSCE_OK;
+}
+
+/* Everything in the header comes from another process, so before trusting it
+ * check that the frame it describes fits in a slot and the slots in the
+ * mapping, without letting any of the sums wrap around. */
+
+static bool valid(const header_t *head, size_t size) {
+	if(size < pad(sizeof(header_t)) || head -> magic != MAGIC) return false;
+	if(head -> colour > 2 || !head -> glyph || head -> glyph > 4)
+		return false;
+
+	const size_t stride = head -> stride;
+	const size_t width = head -> width;
+	const size_t height = head -> height;
+
+	if(stride > (size - pad(sizeof(header_t))) / 3) return false;
+	if(!width || !height || width > stride / height) return false;
+
+	const size_t cells = width * height;
+	const size_t chwidth = LSCb_chwidth(&(LSCb_t) {
+		.colour = head -> colour,
+		.truecolour = head -> colour == 2,
+		.glyph = head -> glyph
+	});
+
+	if(cells > stride / sizeof(double) || cells > stride / chwidth)
+		return false;
+
+	return pad(sizeof(double) * cells)
+		+ pad(sizeof(uint64_t) * height)
+		+ pad(LSCb_tiles(width, height))
+		+ pad(chwidth * cells + 1) <= stride;
+}
+
+int LSCm_open(LSCm_t *shm, const char *name) {
+	int fd = shm_open(name, O_RDWR, 0);
+	if(fd == -1) return fail(shm, "mman");
+	return LSCm_attach(shm, fd);
+}
+
+int LSCm_attach(LSCm_t *shm, int fd) {
+	struct stat st;
+
+	shm -> fd = fd;
+	shm -> owner = false;
+
+	if(fstat(fd, &st) == -1) return fail(shm, "stat");
+	shm -> size = st.st_size;
+
+	shm -> map = mmap(NULL, shm -> size, PROT_READ | PROT_WRITE,
+		MAP_SHARED, fd, 0);
+
+	if(shm -> map == MAP_FAILED) {
+		shm -> map = NULL;
+		return fail(shm, "mman");
+	}
+
+	const header_t *head = shm -> map;
+	if(!valid(head, shm -> size)) {
+		LSC_errno = LSC_SHM_ERR;
+		LSCm_free(shm);
+		return LSCE_NOOP;
+	}
+
+	LSCb_t *buf = &shm -> buf;
+	buf -> colour = head -> colour;
+	buf -> truecolour = head -> colour == 2;
+	buf -> glyph = head -> glyph;
+	buf -> chwidth = LSCb_chwidth(buf);
+	buf -> width = head -> width;
+	buf -> height = head -> height;
+
+	shm -> stride = head -> stride;
+	shm -> slot = 2;
+	point(shm);
+
+	return LSCE_OK;
+}
+
+void LSCm_publish(LSCm_t *shm) {
+	header_t *head = shm -> map;
+
+	shm -> slot = atomic_exchange(&head -> state, shm -> slot | FRESH) & 3;
+	point(shm);
+}
+
+bool LSCm_acquire(LSCm_t *shm) {
+	header_t *head = shm -> map;
+	if(!(atomic_load(&head -> state) & FRESH)) return false;
+
+	shm -> slot = atomic_exchange(&head -> state, shm -> slot) & 3;
+	point(shm);
+
+	return true;
+}
@@ -0,0 +1,63 @@
+/* libScricon: The Simple Graphical Console Library
+ * Copyright (C) 2021-2022 Jyothiraditya Nellakra
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <threads.h>
+#include <time.h>
+
+#include <LSC_stats.h>
+
+#ifdef LSC_STATS
+const bool LSCs_enabled = true;
+#else
+const bool LSCs_enabled = false;
+#endif
+
+thread_local LSCs_t LSCs_local;
+
+uint64_t LSCs_now() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+void LSCs_snap(LSCs_t *stats, bool reset) {
+	if(stats) *stats = LSCs_local;
+	if(reset) memset(&LSCs_local, 0, sizeof(LSCs_t));
+}
+
+void LSCs_add(LSCs_t *total, const LSCs_t *stats) {
+	total -> primitives += stats -> primitives;
+	total -> clipped += stats -> clipped;
+
+	total -> tested += stats -> tested;
+	total -> depth_tested += stats -> depth_tested;
+	total -> written += stats -> written;
+	total -> rejected += stats -> rejected;
+
+	total -> clears += stats -> clears;
+	total -> scrolls += stats -> scrolls;
+	total -> frames += stats -> frames;
+	total -> dropped += stats -> dropped;
+
+	total -> encoded += stats -> encoded;
+	total -> sent += stats -> sent;
+
+	total -> encode_ns += stats -> encode_ns;
+	total -> write_ns += stats -> write_ns;
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+/* libScricon: The Simple Graphical Console Library
+ * Copyright (C) 2021-2022 Jyothiraditya Nellakra
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#include <signal.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#include <sys/ioctl.h>
+
+#include <LSC_error.h>
+#include <LSC_terminal.h>
+
+static atomic_bool resized;
+
+int LSC_winsize(int fd, size_t *width, size_t *height) {
+	struct winsize ws;
+
+	if(ioctl(fd, TIOCGWINSZ, &ws) == -1) {
+		if(LSCe_auto) perror("ioctl");
+		LSC_errno = LSC_IOCTL_ERR;
+		return LSCE_NOOP;
+	}
+
+	if(!ws.ws_col || !ws.ws_row) {
+		LSC_errno = LSC_IOCTL_ERR;
+		return LSCE_NOOP;
+	}
+
+	*width = ws.ws_col;
+	*height = ws.ws_row;
+	return LSCE_OK;
+}
+
+static void on_winch(int signum) {
+	(void) signum;
+	atomic_store(&resized, true);
+}
+
+int LSC_winch() {
+	struct sigaction sa = {0};
+	sa.sa_handler = on_winch;
+	sa.sa_flags = SA_RESTART;
+	sigemptyset(&sa.sa_mask);
+
+	if(sigaction(SIGWINCH, &sa, NULL) == -1) {
+		if(LSCe_auto) perror("signal");
+		LSC_errno = LSC_IOCTL_ERR;
+		return LSCE_NOOP;
+	}
+
+	return LSCE_OK;
+}
+
+bool LSC_resized() {
+	return atomic_exchange(&resized, false);
+}
@@ -0,0 +1,157 @@
+/* libScricon: The Simple Graphical Console Library
+ * Copyright (C) 2021-2022 Jyothiraditya Nellakra
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <threads.h>
+
+#include <unistd.h>
+
+#ifdef LSC_USDT
+#include <sys/sdt.h>
+#endif
+
+#include <LSC_error.h>
+#include <LSC_stats.h>
+#include <LSC_trace.h>
+
+typedef struct {
+	const char *name;
+	uint64_t ts;
+	char phase;
+
+} event_t;
+
+typedef struct ring_s {
+	struct ring_s *next;
+	size_t tid, size;
+
+	atomic_size_t head;
+	event_t events[];
+
+} ring_t;
+
+size_t LSCx_size = 65536;
+
+static _Atomic(ring_t *) rings;
+static atomic_size_t tids;
+static thread_local ring_t *local;
+
+static ring_t *get_ring() {
+	if(local) return local;
+
+	local = malloc(sizeof(ring_t) + LSCx_size * sizeof(event_t));
+	if(!local) return NULL;
+
+	local -> tid = atomic_fetch_add(&tids, 1) + 1;
+	local -> size = LSCx_size;
+	atomic_init(&local -> head, 0);
+
+	local -> next = atomic_load(&rings);
+	while(!atomic_compare_exchange_weak(&rings, &local -> next, local));
+
+	return local;
+}
+
+static void record(const char *name, char phase) {
+	ring_t *ring = get_ring();
+	if(!ring || !ring -> size) return;
+
+	size_t head = atomic_load_explicit(&ring -> head, memory_order_relaxed);
+	event_t *event = &ring -> events[head % ring -> size];
+
+	event -> name = name;
+	event -> ts = LSCs_now();
+	event -> phase = phase;
+
+	atomic_store_explicit(&ring -> head, head + 1, memory_order_release);
+}
+
+void LSCx_begin(const char *name) {
+#ifdef LSC_USDT
+	DTRACE_PROBE1(libScricon, begin, name);
+#endif
+
+	record(name, 'B');
+}
+
+void LSCx_end(const char *name) {
+#ifdef LSC_USDT
+	DTRACE_PROBE1(libScricon, end, name);
+#endif
+
+	record(name, 'E');
+}
+
+/* Event names can be any string, so quotes, backslashes and control
+ * characters in them are escaped to keep the trace valid JSON. */
+
+static int quote(FILE *file, const char *name) {
+	for(; *name; name++) {
+		const unsigned char c = *name;
+		int ret;
+
+		if(c == '"' || c == '\\') ret = fprintf(file, "\\%c", c);
+		else if(c < 0x20) ret = fprintf(file, "\\u%04x", c);
+		else ret = fputc(c, file) == EOF? -1: 1;
+
+		if(ret < 0) return ret;
+	}
+
+	return 0;
+}
+
+int LSCx_dump(FILE *file) {
+	const char *sep = "";
+	int ret = fprintf(file, "{\"traceEvents\": [");
+	if(ret < 0) goto error;
+
+	for(ring_t *ring = atomic_load(&rings); ring; ring = ring -> next) {
+		size_t head = atomic_load_explicit(&ring -> head,
+			memory_order_acquire);
+
+		size_t tail = head > ring -> size? head - ring -> size: 0;
+
+		for(size_t i = tail; i < head; i++) {
+			event_t *event = &ring -> events[i % ring -> size];
+
+			ret = fprintf(file, "%s\n  {\"name\": \"", sep);
+			if(ret < 0 || quote(file, event -> name) < 0)
+				goto error;
+
+			ret = fprintf(file, "\", \"ph\": \"%c\", \"ts\": %.3f, "
+				"\"pid\": %ld, \"tid\": %zu}", event -> phase,
+				event -> ts / 1000.0, (long) getpid(),
+				ring -> tid);
+
+			if(ret < 0) goto error;
+			sep = ",";
+		}
+	}
+
+	ret = fprintf(file, "\n], \"displayTimeUnit\": \"ms\"}\n");
+	if(ret < 0) goto error;
+
+	return LSCE_OK;
+
+error:
+	if(LSCe_auto) perror("stdlib");
+	LSC_errno = LSC_PRINTF_ERR;
+	return LSCE_NOOP;
+}
\ No newline at end of file
@@ -17,9 +17,11 @@
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
-#include <stdio.h>
 
+#include <LSC_braille.h>
 #include <LSC_buffer.h>
+#include <LSC_colour.h>
+#include <LSC_stats.h>
 #include <LSC_triangles.h>
 
 typedef struct {
@@ -47,6 +49,7 @@ static void algorithm(call_t call, intmax_t x1, intmax_t y1, intmax_t x2,
 	intmax_t miny = min(y1, y2, y3), maxy = max(y1, y2, y3);
 
 	intmax_t oy = miny;
+	LSCS_ADD(tested, (maxx - minx) * (maxy - miny));
 
 	double c1 = dy12 * x1 - dx12 * y1;
 	double c2 = dy23 * x2 - dx23 * y2;
@@ -76,12 +79,13 @@ void LSCt_set(LSCb_t *buf, size_t x1, size_t y1, size_t x2, size_t y2,
 	size_t x3, size_t y3, char chr)
 {
 	bool validate = buf -> validate == LSCB_VALIDATE_CHAR;
+	LSCS_ADD(primitives, 1);
 
 	if(buf -> validate == LSCB_VALIDATE_SHAPE) {
 		if(x1 >= buf -> width || y1 >= buf -> height
 			|| x2 >= buf -> width || y2 >= buf -> height
 			|| x3 >= buf -> width || y3 >= buf -> height)
-		{ return; }
+		{ LSCS_ADD(clipped, 1); return; }
 	}
 
 	char data[2] = {chr, ' '};
@@ -95,18 +99,19 @@ void LSCt_setcol(LSCb_t *buf, size_t x1, size_t y1, size_t x2, size_t y2,
 	size_t x3, size_t y3, uint8_t fg, uint8_t bg)
 {
 	bool validate = buf -> validate == LSCB_VALIDATE_CHAR;
+	LSCS_ADD(primitives, 1);
 
 	if(buf -> validate == LSCB_VALIDATE_SHAPE) {
 		if(x1 >= buf -> width || y1 >= buf -> height
 			|| x2 >= buf -> width || y2 >= buf -> height
 			|| x3 >= buf -> width || y3 >= buf -> height)
-		{ return; }
+		{ LSCS_ADD(clipped, 1); return; }
 	}
 
 	char data[23];
 	call_t call = {validate? LSCb_setcolsv: LSCb_setcols, buf, " "};
 
-	sprintf(data, "\033[48;5;%03um\033[38;5;%03um", bg, fg);
+	LSCc_col(data, fg, bg);
 	call.data = data;
 
 	algorithm(call, x1, y1, x2, y2, x3, y3);
@@ -116,18 +121,19 @@ void LSCt_setfg(LSCb_t *buf, size_t x1, size_t y1, size_t x2, size_t y2,
 	size_t x3, size_t y3, uint8_t fg)
 {
 	bool validate = buf -> validate == LSCB_VALIDATE_CHAR;
+	LSCS_ADD(primitives, 1);
 
 	if(buf -> validate == LSCB_VALIDATE_SHAPE) {
 		if(x1 >= buf -> width || y1 >= buf -> height
 			|| x2 >= buf -> width || y2 >= buf -> height
 			|| x3 >= buf -> width || y3 >= buf -> height)
-		{ return; }
+		{ LSCS_ADD(clipped, 1); return; }
 	}
 
-	char data[12];
+	char data[11];
 	call_t call = {validate? LSCb_setfgsv: LSCb_setfgs, buf, " "};
 
-	sprintf(data, "\033[38;5;%03um", fg);
+	LSCc_fg(data, fg);
 	call.data = data;
 
 	algorithm(call, x1, y1, x2, y2, x3, y3);
@@ -137,18 +143,19 @@ void LSCt_setbg(LSCb_t *buf, size_t x1, size_t y1, size_t x2, size_t y2,
 	size_t x3, size_t y3, uint8_t bg)
 {
 	bool validate = buf -> validate == LSCB_VALIDATE_CHAR;
+	LSCS_ADD(primitives, 1);
 
 	if(buf -> validate == LSCB_VALIDATE_SHAPE) {
 		if(x1 >= buf -> width || y1 >= buf -> height
 			|| x2 >= buf -> width || y2 >= buf -> height
 			|| x3 >= buf -> width || y3 >= buf -> height)
-		{ return; }
+		{ LSCS_ADD(clipped, 1); return; }
 	}
 
-	char data[12];
+	char data[11];
 	call_t call = {validate? LSCb_setbgsv: LSCb_setbgs, buf, " "};
 
-	sprintf(data, "\033[48;5;%03um", bg);
+	LSCc_bg(data, bg);
 	call.data = data;
 
 	algorithm(call, x1, y1, x2, y2, x3, y3);
@@ -158,19 +165,52 @@ void LSCt_setall(LSCb_t *buf, size_t x1, size_t y1, size_t x2, size_t y2,
 	size_t x3, size_t y3, char chr, uint8_t fg, uint8_t bg)
 {
 	bool validate = buf -> validate == LSCB_VALIDATE_CHAR;
+	LSCS_ADD(primitives, 1);
 
 	if(buf -> validate == LSCB_VALIDATE_SHAPE) {
 		if(x1 >= buf -> width || y1 >= buf -> height
 			|| x2 >= buf -> width || y2 >= buf -> height
 			|| x3 >= buf -> width || y3 >= buf -> height)
-		{ return; }
+		{ LSCS_ADD(clipped, 1); return; }
 	}
 
-	char data[24];
+	char data[23];
 	call_t call = {validate? LSCb_setallsv: LSCb_setalls, buf, " "};
 
-	sprintf(data, "\033[48;5;%03um\033[38;5;%03um%c", bg, fg, chr);
+	LSCc_col(data, fg, bg);
+	data[22] = chr;
 	call.data = data;
 
 	algorithm(call, x1, y1, x2, y2, x3, y3);
-}
\ No newline at end of file
+}
+
+static void dot(LSCb_t *buf, size_t x, size_t y, const char *data) {
+	(void) data; LSCd_set(buf, x, y);
+}
+
+static void dotv(LSCb_t *buf, size_t x, size_t y, const char *data) {
+	(void) data;
+	if(x < 2 * buf -> width && y < 4 * buf -> height) LSCd_set(buf, x, y);
+}
+
+/* Fills a triangle on a braille canvas's mask buffer, which is twice as many
+ * dots wide and four times as many tall as it is cells. */
+
+void LSCt_dots(LSCb_t *dots, size_t x1, size_t y1, size_t x2, size_t y2,
+	size_t x3, size_t y3)
+{
+	bool validate = dots -> validate == LSCB_VALIDATE_CHAR;
+	LSCS_ADD(primitives, 1);
+
+	if(dots -> validate == LSCB_VALIDATE_SHAPE) {
+		const size_t width = dots -> width * 2;
+		const size_t height = dots -> height * 4;
+
+		if(x1 >= width || x2 >= width || x3 >= width
+			|| y1 >= height || y2 >= height || y3 >= height)
+		{ LSCS_ADD(clipped, 1); return; }
+	}
+
+	call_t call = {validate? dotv: dot, dots, NULL};
+	algorithm(call, x1, y1, x2, y2, x3, y3);
+}
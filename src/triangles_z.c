@@ -17,9 +17,10 @@
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
-#include <stdio.h>
 
 #include <LSC_buffer.h>
+#include <LSC_colour.h>
+#include <LSC_stats.h>
 #include <LSC_triangles.h>
 #include <LSC_vector.h>
 
@@ -55,6 +56,7 @@ static void algorithm(call_t call, intmax_t x1, intmax_t y1, double z1,
 	intmax_t miny = min(y1, y2, y3), maxy = max(y1, y2, y3);
 
 	intmax_t oy = miny;
+	LSCS_ADD(tested, (maxx - minx) * (maxy - miny));
 
 	double c1 = dy12 * x1 - dx12 * y1;
 	double c2 = dy23 * x2 - dx23 * y2;
@@ -87,12 +89,13 @@ void LSCt_setz(LSCb_t *buf, size_t x1, size_t y1, double z1,
 	size_t x3, size_t y3, double z3, char chr)
 {
 	bool validate = buf -> validate == LSCB_VALIDATE_CHAR;
+	LSCS_ADD(primitives, 1);
 
 	if(buf -> validate == LSCB_VALIDATE_SHAPE) {
 		if(x1 >= buf -> width || y1 >= buf -> height
 			|| x2 >= buf -> width || y2 >= buf -> height
 			|| x3 >= buf -> width || y3 >= buf -> height)
-		{ return; }
+		{ LSCS_ADD(clipped, 1); return; }
 	}
 
 	char data[2] = {chr, ' '};
@@ -107,19 +110,20 @@ void LSCt_setcolz(LSCb_t *buf, size_t x1, size_t y1, double z1,
 	size_t x3, size_t y3, double z3, uint8_t fg, uint8_t bg)
 {
 	bool validate = buf -> validate == LSCB_VALIDATE_CHAR;
+	LSCS_ADD(primitives, 1);
 
 	if(buf -> validate == LSCB_VALIDATE_SHAPE) {
 		if(x1 >= buf -> width || y1 >= buf -> height
 			|| x2 >= buf -> width || y2 >= buf -> height
 			|| x3 >= buf -> width || y3 >= buf -> height)
-		{ return; }
+		{ LSCS_ADD(clipped, 1); return; }
 	}
 
 	char data[23];
 	call_t call = {validate? LSCb_setcolszv: LSCb_setcolsz,
 		buf, " "};
 
-	sprintf(data, "\033[48;5;%03um\033[38;5;%03um", bg, fg);
+	LSCc_col(data, fg, bg);
 	call.data = data;
 
 	algorithm(call, x1, y1, z1, x2, y2, z2, x3, y3, z3);
@@ -130,18 +134,19 @@ void LSCt_setfgz(LSCb_t *buf, size_t x1, size_t y1, double z1,
 	size_t x3, size_t y3, double z3, uint8_t fg)
 {
 	bool validate = buf -> validate == LSCB_VALIDATE_CHAR;
+	LSCS_ADD(primitives, 1);
 
 	if(buf -> validate == LSCB_VALIDATE_SHAPE) {
 		if(x1 >= buf -> width || y1 >= buf -> height
 			|| x2 >= buf -> width || y2 >= buf -> height
 			|| x3 >= buf -> width || y3 >= buf -> height)
-		{ return; }
+		{ LSCS_ADD(clipped, 1); return; }
 	}
 
-	char data[12];
+	char data[11];
 	call_t call = {validate? LSCb_setfgszv: LSCb_setfgsz, buf, " "};
 
-	sprintf(data, "\033[38;5;%03um", fg);
+	LSCc_fg(data, fg);
 	call.data = data;
 
 	algorithm(call, x1, y1, z1, x2, y2, z2, x3, y3, z3);
@@ -152,18 +157,19 @@ void LSCt_setbgz(LSCb_t *buf, size_t x1, size_t y1, double z1,
 	size_t x3, size_t y3, double z3, uint8_t bg)
 {
 	bool validate = buf -> validate == LSCB_VALIDATE_CHAR;
+	LSCS_ADD(primitives, 1);
 
 	if(buf -> validate == LSCB_VALIDATE_SHAPE) {
 		if(x1 >= buf -> width || y1 >= buf -> height
 			|| x2 >= buf -> width || y2 >= buf -> height
 			|| x3 >= buf -> width || y3 >= buf -> height)
-		{ return; }
+		{ LSCS_ADD(clipped, 1); return; }
 	}
 
-	char data[12];
+	char data[11];
 	call_t call = {validate? LSCb_setbgszv: LSCb_setbgsz, buf, " "};
 
-	sprintf(data, "\033[48;5;%03um", bg);
+	LSCc_bg(data, bg);
 	call.data = data;
 
 	algorithm(call, x1, y1, z1, x2, y2, z2, x3, y3, z3);
@@ -174,19 +180,21 @@ void LSCt_setallz(LSCb_t *buf, size_t x1, size_t y1, double z1,
 	size_t x3, size_t y3, double z3, char chr, uint8_t fg, uint8_t bg)
 {
 	bool validate = buf -> validate == LSCB_VALIDATE_CHAR;
+	LSCS_ADD(primitives, 1);
 
 	if(buf -> validate == LSCB_VALIDATE_SHAPE) {
 		if(x1 >= buf -> width || y1 >= buf -> height
 			|| x2 >= buf -> width || y2 >= buf -> height
 			|| x3 >= buf -> width || y3 >= buf -> height)
-		{ return; }
+		{ LSCS_ADD(clipped, 1); return; }
 	}
 
-	char data[24];
+	char data[23];
 	call_t call = {validate? LSCb_setallszv: LSCb_setallsz,
 		buf, " "};
 
-	sprintf(data, "\033[48;5;%03um\033[38;5;%03um%c", bg, fg, chr);
+	LSCc_col(data, fg, bg);
+	data[22] = chr;
 	call.data = data;
 
 	algorithm(call, x1, y1, z1, x2, y2, z2, x3, y3, z3);